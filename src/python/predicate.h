@@ -11,6 +11,8 @@
 #include <boost/python.hpp>
 
 #include <functional>
+#include <utility>
+#include <vector>
 
 using namespace boost::python;
 using namespace unf;
@@ -35,4 +37,44 @@ static CapturePredicateFunc WrapPredicate(_CapturePredicateFunc fn)
     };
 }
 
+// Evaluate Python function on notices captured within a single batch, so
+// that the GIL is only acquired once per transaction.
+class PyBatchedEvaluator : public CapturePredicate::Evaluator {
+  public:
+    explicit PyBatchedEvaluator(_CapturePredicateFunc fn) : _fn(std::move(fn))
+    {
+    }
+
+    bool operator()(const UnfNotice::StageNotice& notice) const override
+    {
+        TfPyLock lock;
+        return _Invoke(notice);
+    }
+
+    void Evaluate(
+        const std::vector<UnfNotice::StageNoticeRefPtr>& notices,
+        std::vector<bool>& results) const override
+    {
+        TfPyLock lock;
+
+        results.resize(notices.size());
+        for (size_t index = 0; index < notices.size(); ++index) {
+            results[index] = _Invoke(*notices[index]);
+        }
+    }
+
+    bool IsBatched() const override { return true; }
+
+  private:
+    bool _Invoke(const UnfNotice::StageNotice& notice) const
+    {
+        if (!_fn) return true;
+
+        object _notice = Tf_PyNoticeObjectGenerator::Invoke(notice);
+        return _fn(_notice);
+    }
+
+    _CapturePredicateFunc _fn;
+};
+
 #endif  // USD_NOTICE_FRAMEWORK_PYTHON_PREDICATE_H
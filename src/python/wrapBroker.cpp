@@ -10,6 +10,7 @@
 #include <pxr/base/tf/pyPtrHelpers.h>
 #include <pxr/base/tf/weakPtr.h>
 #include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usd/common.h>
 #include <pxr/usd/usd/stage.h>
 
@@ -22,8 +23,26 @@ PXR_NAMESPACE_USING_DIRECTIVE
 
 void Broker_BeginTransaction_WithFunc(Broker& self, object predicate)
 {
-    auto _predicate = WrapPredicate(predicate);
-    self.BeginTransaction(_predicate);
+    // Predicate instances must be passed as is to preserve their evaluator.
+    extract<CapturePredicate> _predicate(predicate);
+    if (_predicate.check()) {
+        self.BeginTransaction(_predicate());
+        return;
+    }
+
+    self.BeginTransaction(CapturePredicate(WrapPredicate(predicate)));
+}
+
+void Broker_BeginTransaction_WithScope(
+    Broker& self, const SdfPathVector& scope, object predicate)
+{
+    extract<CapturePredicate> _predicate(predicate);
+    if (_predicate.check()) {
+        self.BeginTransaction(scope, _predicate());
+        return;
+    }
+
+    self.BeginTransaction(scope, CapturePredicate(WrapPredicate(predicate)));
 }
 
 void wrapBroker()
@@ -58,6 +77,94 @@ void wrapBroker()
             &Broker::IsInTransaction,
             "Indicate whether a notice transaction has been started.")
 
+        .def(
+            "IsStreamingMerge",
+            &Broker::IsStreamingMerge,
+            "Indicate whether mergeable notices are consolidated as soon as "
+            "they are captured.")
+
+        .def(
+            "SetStreamingMerge",
+            &Broker::SetStreamingMerge,
+            arg("enabled"),
+            "Set whether mergeable notices are consolidated as soon as they "
+            "are captured.")
+
+        .def(
+            "GetParallelThreshold",
+            &Broker::GetParallelThreshold,
+            "Return minimum number of notices held at the end of a "
+            "transaction from which notice types are processed concurrently.")
+
+        .def(
+            "SetParallelThreshold",
+            &Broker::SetParallelThreshold,
+            arg("threshold"),
+            "Set minimum number of notices held at the end of a transaction "
+            "from which notice types are processed concurrently.")
+
+        .def(
+            "GetTransactionBudget",
+            &Broker::GetTransactionBudget,
+            "Return number of notices captured within a transaction after "
+            "which mergeable notices are consolidated.")
+
+        .def(
+            "SetTransactionBudget",
+            &Broker::SetTransactionBudget,
+            arg("budget"),
+            "Set number of notices captured within a transaction after "
+            "which mergeable notices are consolidated.")
+
+        .def(
+            "IsThreadLocalTransactions",
+            &Broker::IsThreadLocalTransactions,
+            "Indicate whether each thread keeps its own stack of "
+            "transactions.")
+
+        .def(
+            "SetThreadLocalTransactions",
+            &Broker::SetThreadLocalTransactions,
+            arg("enabled"),
+            "Set whether each thread keeps its own stack of transactions.")
+
+        .def(
+            "IsAutoBatching",
+            &Broker::IsAutoBatching,
+            "Indicate whether notices are batched outside of transactions.")
+
+        .def(
+            "SetAutoBatching",
+            &Broker::SetAutoBatching,
+            arg("enabled"),
+            "Set whether notices are batched outside of transactions.")
+
+        .def(
+            "GetAutoBatchThreshold",
+            &Broker::GetAutoBatchThreshold,
+            "Return maximum number of notices batched before being emitted.")
+
+        .def(
+            "SetAutoBatchThreshold",
+            &Broker::SetAutoBatchThreshold,
+            arg("threshold"),
+            "Set maximum number of notices batched before being emitted.")
+
+        .def(
+            "GetAutoBatchInterval",
+            &Broker::GetAutoBatchInterval,
+            "Return interval in seconds after which batched notices are "
+            "emitted.")
+
+        .def(
+            "SetAutoBatchInterval",
+            &Broker::SetAutoBatchInterval,
+            arg("interval"),
+            "Set interval in seconds after which batched notices are "
+            "emitted.")
+
+        .def("Tick", &Broker::Tick, "Emit notices batched since last call.")
+
         .def(
             "BeginTransaction",
             (void(Broker::*)(CapturePredicate)) & Broker::BeginTransaction,
@@ -70,6 +177,14 @@ void wrapBroker()
             ((arg("self"), arg("predicate"))),
             "Start a notice transaction with a function predicate.")
 
+        .def(
+            "BeginTransaction",
+            &Broker_BeginTransaction_WithScope,
+            ((arg("self"),
+              arg("scope"),
+              arg("predicate") = CapturePredicate::Default())),
+            "Start a notice transaction restricted to a set of subtrees.")
+
         .def(
             "EndTransaction",
             &Broker::EndTransaction,
@@ -2,13 +2,70 @@
 
 #include "unf/capturePredicate.h"
 
+#include <pxr/base/tf/pyObjWrapper.h>
+#include <pxr/base/tf/type.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+
 #include <boost/python.hpp>
 
+#include <memory>
+#include <vector>
+
 using namespace boost::python;
 using namespace unf;
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
+// Convert sequence of notice classes or Tf.Type instances into types.
+static std::vector<TfType> _ExtractTypes(const object& sequence)
+{
+    std::vector<TfType> types;
+
+    for (stl_input_iterator<object> it(sequence), end; it != end; ++it) {
+        extract<TfType> type(*it);
+        if (type.check()) {
+            types.push_back(type());
+        }
+        else {
+            types.push_back(TfType::FindByPythonClass(TfPyObjWrapper(*it)));
+        }
+    }
+
+    return types;
+}
+
+static CapturePredicate CapturePredicate_AllowTypes(const object& types)
+{
+    return CapturePredicate::AllowTypes(_ExtractTypes(types));
+}
+
+static CapturePredicate CapturePredicate_BlockTypes(const object& types)
+{
+    return CapturePredicate::BlockTypes(_ExtractTypes(types));
+}
+
+static CapturePredicate CapturePredicate_UnderPaths(const object& prefixes)
+{
+    SdfPathVector paths;
+    for (stl_input_iterator<SdfPath> it(prefixes), end; it != end; ++it) {
+        paths.push_back(*it);
+    }
+
+    return CapturePredicate::UnderPaths(paths);
+}
+
+static CapturePredicate CapturePredicate_PerType(
+    const _CapturePredicateFunc& function)
+{
+    return CapturePredicate::PerType(WrapPredicate(function));
+}
+
+static CapturePredicate CapturePredicate_Batched(
+    const _CapturePredicateFunc& function)
+{
+    return CapturePredicate(std::make_shared<PyBatchedEvaluator>(function));
+}
 
 void wrapCapturePredicate()
 {
@@ -28,5 +85,66 @@ void wrapCapturePredicate()
             "BlockAll",
             &CapturePredicate::BlockAll,
             "Create a predicate which return false for each notice type.")
-        .staticmethod("BlockAll");
+        .staticmethod("BlockAll")
+
+        .def(
+            "AllowTypes",
+            &CapturePredicate_AllowTypes,
+            arg("types"),
+            "Create a predicate which only return true for notices of types.")
+        .staticmethod("AllowTypes")
+
+        .def(
+            "BlockTypes",
+            &CapturePredicate_BlockTypes,
+            arg("types"),
+            "Create a predicate which return false for notices of types.")
+        .staticmethod("BlockTypes")
+
+        .def(
+            "UnderPaths",
+            &CapturePredicate_UnderPaths,
+            arg("prefixes"),
+            "Create a predicate which only return true for ObjectsChanged "
+            "notices affecting paths under prefixes.")
+        .staticmethod("UnderPaths")
+
+        .def(
+            "And",
+            &CapturePredicate::And,
+            (arg("first"), arg("second")),
+            "Create a predicate which return true if both predicates return "
+            "true.")
+        .staticmethod("And")
+
+        .def(
+            "Or",
+            &CapturePredicate::Or,
+            (arg("first"), arg("second")),
+            "Create a predicate which return true if either predicate returns "
+            "true.")
+        .staticmethod("Or")
+
+        .def(
+            "Not",
+            &CapturePredicate::Not,
+            arg("predicate"),
+            "Create a predicate which return the opposite of a predicate.")
+        .staticmethod("Not")
+
+        .def(
+            "PerType",
+            &CapturePredicate_PerType,
+            arg("function"),
+            "Create a predicate from a function which only depends on the "
+            "notice type.")
+        .staticmethod("PerType")
+
+        .def(
+            "Batched",
+            &CapturePredicate_Batched,
+            arg("function"),
+            "Create a predicate from a function evaluated on all notices "
+            "captured when the transaction ends.")
+        .staticmethod("Batched");
 }
@@ -6,6 +6,7 @@
 #include <pxr/base/tf/pyContainerConversions.h>
 #include <pxr/base/tf/pyNoticeWrapper.h>
 #include <pxr/base/tf/pyResultConversions.h>
+#include <pxr/base/tf/pyUtils.h>
 
 #include <pxr/pxr.h>
 
@@ -26,6 +27,65 @@ TF_INSTANTIATE_NOTICE_WRAPPER(LayerMutingChanged, StageNotice);
 
 }  // anonymous namespace
 
+// Return copy of list cached on the Python notice object under 'key', and
+// build it from the C++ notice on first access. The cached list is copied so
+// that modifications from the caller do not affect subsequent calls.
+template <class Getter>
+object _GetCachedList(object self, const char* key, Getter getter)
+{
+    dict attributes = extract<dict>(self.attr("__dict__"));
+    if (!attributes.has_key(key)) {
+        const ObjectsChanged& notice = extract<const ObjectsChanged&>(self);
+        attributes[key] = TfPyCopySequenceToList(getter(notice));
+    }
+
+    return list(attributes[key]);
+}
+
+object ObjectsChanged_GetResyncedPaths(object self)
+{
+    auto getter = [](const ObjectsChanged& n) -> const SdfPathVector& {
+        return n.GetResyncedPaths();
+    };
+    return _GetCachedList(self, "_resyncedPaths", getter);
+}
+
+object ObjectsChanged_GetChangedInfoOnlyPaths(object self)
+{
+    auto getter = [](const ObjectsChanged& n) -> const SdfPathVector& {
+        return n.GetChangedInfoOnlyPaths();
+    };
+    return _GetCachedList(self, "_changedInfoOnlyPaths", getter);
+}
+
+// Only look up fields for requested path, as expanding all changed fields
+// would be wasteful for a single query.
+list ObjectsChanged_GetChangedFields(
+    const ObjectsChanged& self, const SdfPath& path)
+{
+    return TfPyCopySequenceToList(self.GetChangedFields(path));
+}
+
+list ObjectsChanged_GetChangedFieldsFromObject(
+    const ObjectsChanged& self, const UsdObject& object)
+{
+    return TfPyCopySequenceToList(self.GetChangedFields(object));
+}
+
+SdfPathVector ObjectsChanged_FindResyncedPaths(
+    const ObjectsChanged& self, const SdfPath& root)
+{
+    auto range = self.FindResyncedPaths(root);
+    return SdfPathVector(range.begin(), range.end());
+}
+
+SdfPathVector ObjectsChanged_FindChangedInfoOnlyPaths(
+    const ObjectsChanged& self, const SdfPath& root)
+{
+    auto range = self.FindChangedInfoOnlyPaths(root);
+    return SdfPathVector(range.begin(), range.end());
+}
+
 // Dummy class to reproduce namespace in Python.
 class PythonUnfNotice {};
 
@@ -71,32 +131,42 @@ void wrapNotice()
 
         .def(
             "GetResyncedPaths",
-            &ObjectsChanged::GetResyncedPaths,
-            "Return list of paths that are resynced in lexicographical order.",
-            return_value_policy<return_by_value>())
+            &ObjectsChanged_GetResyncedPaths,
+            "Return list of paths that are resynced in lexicographical order.")
 
         .def(
             "GetChangedInfoOnlyPaths",
-            &ObjectsChanged::GetChangedInfoOnlyPaths,
+            &ObjectsChanged_GetChangedInfoOnlyPaths,
             "Return list of paths that are modified but not resynced in "
-            "lexicographical order.",
-            return_value_policy<return_by_value>())
+            "lexicographical order.")
+
+        .def(
+            "FindResyncedPaths",
+            &ObjectsChanged_FindResyncedPaths,
+            arg("root"),
+            "Return list of resynced paths which are root or its descendants, "
+            "in lexicographical order.",
+            return_value_policy<TfPySequenceToList>())
+
+        .def(
+            "FindChangedInfoOnlyPaths",
+            &ObjectsChanged_FindChangedInfoOnlyPaths,
+            arg("root"),
+            "Return list of paths modified but not resynced which are root or "
+            "its descendants, in lexicographical order.",
+            return_value_policy<TfPySequenceToList>())
 
         .def(
             "GetChangedFields",
-            (unf::TfTokenSet(ObjectsChanged::*)(const SdfPath&) const)
-                & ObjectsChanged::GetChangedFields,
+            &ObjectsChanged_GetChangedFields,
             "Return the list of changed fields in layers that affected the "
-            "path",
-            return_value_policy<TfPySequenceToList>())
+            "path")
 
         .def(
             "GetChangedFields",
-            (unf::TfTokenSet(ObjectsChanged::*)(const UsdObject&) const)
-                & ObjectsChanged::GetChangedFields,
+            &ObjectsChanged_GetChangedFieldsFromObject,
             "Return the list of changed fields in layers that affected the "
-            "object",
-            return_value_policy<TfPySequenceToList>())
+            "object")
 
         .def(
             "HasChangedFields",
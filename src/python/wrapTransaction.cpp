@@ -6,6 +6,7 @@
 
 #include <pxr/base/tf/pyFunction.h>
 #include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usd/common.h>
 #include <pxr/usd/usd/stage.h>
 
@@ -55,6 +56,52 @@ struct PythonNoticeTransaction {
         };
     }
 
+    PythonNoticeTransaction(
+        const BrokerWeakPtr& broker,
+        const SdfPathVector& scope,
+        const _CapturePredicateFunc& func)
+        : _func(func)
+    {
+        _makeContext = [=]() {
+            return new NoticeTransaction(
+                broker, scope, CapturePredicate(WrapPredicate(_func)));
+        };
+    }
+
+    PythonNoticeTransaction(
+        const BrokerWeakPtr& broker,
+        const SdfPathVector& scope,
+        CapturePredicate predicate)
+        : _predicate(predicate)
+    {
+        _makeContext = [=]() {
+            return new NoticeTransaction(broker, scope, _predicate);
+        };
+    }
+
+    PythonNoticeTransaction(
+        const UsdStageWeakPtr& stage,
+        const SdfPathVector& scope,
+        const _CapturePredicateFunc& func)
+        : _func(func)
+    {
+        _makeContext = [=]() {
+            return new NoticeTransaction(
+                stage, scope, CapturePredicate(WrapPredicate(_func)));
+        };
+    }
+
+    PythonNoticeTransaction(
+        const UsdStageWeakPtr& stage,
+        const SdfPathVector& scope,
+        CapturePredicate predicate)
+        : _predicate(predicate)
+    {
+        _makeContext = [=]() {
+            return new NoticeTransaction(stage, scope, _predicate);
+        };
+    }
+
     // Instantiate the C++ class object and hold it by shared_ptr.
     PythonNoticeTransaction const* __enter__()
     {
@@ -104,6 +151,42 @@ void wrapTransaction()
             "Create transaction from a UsdStage with a capture predicate "
             "function."))
 
+        .def(init<
+             const BrokerWeakPtr&,
+             const SdfPathVector&,
+             CapturePredicate>(
+            (arg("broker"),
+             arg("scope"),
+             arg("predicate") = CapturePredicate::Default()),
+            "Create transaction from a Broker restricted to a set of "
+            "subtrees."))
+
+        .def(init<
+             const BrokerWeakPtr&,
+             const SdfPathVector&,
+             const _CapturePredicateFunc&>(
+            (arg("broker"), arg("scope"), arg("predicate")),
+            "Create transaction from a Broker restricted to a set of subtrees "
+            "with a capture predicate function."))
+
+        .def(init<
+             const UsdStageWeakPtr&,
+             const SdfPathVector&,
+             CapturePredicate>(
+            (arg("stage"),
+             arg("scope"),
+             arg("predicate") = CapturePredicate::Default()),
+            "Create transaction from a UsdStage restricted to a set of "
+            "subtrees."))
+
+        .def(init<
+             const UsdStageWeakPtr&,
+             const SdfPathVector&,
+             const _CapturePredicateFunc&>(
+            (arg("stage"), arg("scope"), arg("predicate")),
+            "Create transaction from a UsdStage restricted to a set of "
+            "subtrees with a capture predicate function."))
+
         .def(
             "__enter__",
             &PythonNoticeTransaction::__enter__,
@@ -3,20 +3,340 @@
 #include "unf/dispatcher.h"
 #include "unf/notice.h"
 
+#include <pxr/base/tf/diagnostic.h>
 #include <pxr/base/tf/weakPtr.h>
 #include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usd/common.h>
 #include <pxr/usd/usd/notice.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace unf {
 
-// Initiate static registry.
-std::unordered_map<UsdStageWeakPtr, BrokerPtr, Broker::UsdStageWeakPtrHasher>
-    Broker::Registry;
+namespace {
+
+struct _UsdStageWeakPtrHasher {
+    std::size_t operator()(const UsdStageWeakPtr& ptr) const
+    {
+        return hash_value(ptr);
+    }
+};
+
+// Registry recording each stage pointer to its corresponding broker pointer.
+//
+// Brokers are organized within shards protected by their own lock, so that
+// brokers targeting distinct stages can be created and retrieved
+// concurrently with little contention.
+class _BrokerRegistry {
+  public:
+    static _BrokerRegistry& GetInstance()
+    {
+        static _BrokerRegistry registry;
+        return registry;
+    }
+
+    // Return broker registered for stage, or null pointer.
+    BrokerPtr Find(const UsdStageWeakPtr& stage)
+    {
+        auto& shard = _GetShard(stage);
+
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.brokers.find(stage);
+        if (it == shard.brokers.end()) return nullptr;
+        return it->second;
+    }
+
+    // Register broker for stage if none is registered, and return the broker
+    // registered. The broker must be constructed beforehand, so that the
+    // lock is not held while dispatchers are created and registered.
+    BrokerPtr Insert(const UsdStageWeakPtr& stage, const BrokerPtr& broker)
+    {
+        auto& shard = _GetShard(stage);
+
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto result = shard.brokers.emplace(stage, broker);
+        return result.first->second;
+    }
+
+    // Record broker newly registered for stage, and inspect a constant
+    // number of the oldest records to un-register brokers targeting
+    // expired stages.
+    //
+    // Records are inspected in a round-robin fashion, so that each expired
+    // stage is eventually reclaimed while keeping the cost of each
+    // insertion constant. Stages tend to be released together, so
+    // inspection continues while the oldest records are expired, which
+    // reclaims consecutive expired records at once. As each record is only
+    // reclaimed once, the amortized cost of each insertion remains constant.
+    void Collect(const UsdStageWeakPtr& stage, const BrokerPtr& broker)
+    {
+        std::vector<_Record> expired;
+        {
+            std::lock_guard<std::mutex> lock(_recordMutex);
+            _records.push_back({stage, broker});
+
+            size_t inspected = 0;
+
+            while (!_records.empty()) {
+                const _Record& front = _records.front();
+                bool released = !front.broker || front.stage.IsExpired();
+
+                // Stop at the first live record once enough records were
+                // inspected.
+                if (!released && inspected >= _collectStep) break;
+                inspected++;
+
+                _Record record = std::move(_records.front());
+                _records.pop_front();
+
+                // Broker has already been released from the registry.
+                if (!record.broker) continue;
+
+                if (record.stage.IsExpired()) {
+                    expired.push_back(std::move(record));
+                }
+                else {
+                    _records.push_back(std::move(record));
+                }
+            }
+        }
+
+        for (auto& record : expired) {
+            _Erase(record.stage, get_pointer(record.broker));
+        }
+    }
+
+    void Erase(const UsdStageWeakPtr& stage) { _Erase(stage, nullptr); }
+
+    void Clear()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_recordMutex);
+            _records.clear();
+        }
+
+        for (auto& shard : _shards) {
+            _BrokerMap brokers;
+            {
+                std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                brokers.swap(shard.brokers);
+            }
+        }
+    }
+
+  private:
+    // Un-register broker for stage, only if it matches \p target when
+    // specified.
+    void _Erase(const UsdStageWeakPtr& stage, const Broker* target)
+    {
+        auto& shard = _GetShard(stage);
+
+        // Release broker once lock is released, as destroying it revokes
+        // its dispatchers.
+        BrokerPtr broker;
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.brokers.find(stage);
+            if (it == shard.brokers.end()) return;
+            if (target && get_pointer(it->second) != target) return;
+
+            broker = std::move(it->second);
+            shard.brokers.erase(it);
+        }
+    }
+
+    using _BrokerMap =
+        std::unordered_map<UsdStageWeakPtr, BrokerPtr, _UsdStageWeakPtrHasher>;
+
+    struct _Shard {
+        std::shared_mutex mutex;
+        _BrokerMap brokers;
+    };
+
+    // Number of bits used to address shards.
+    static constexpr int _shardBits = 6;
+
+    _Shard& _GetShard(const UsdStageWeakPtr& stage)
+    {
+        // Mix hash as stage pointers are aligned, and keep highest bits.
+        uint64_t hash = _UsdStageWeakPtrHasher()(stage);
+        hash *= 0x9E3779B97F4A7C15ULL;
+        return _shards[hash >> (64 - _shardBits)];
+    }
+
+    std::array<_Shard, size_t(1) << _shardBits> _shards;
+
+    // Brokers registered, in order of inspection.
+    struct _Record {
+        UsdStageWeakPtr stage;
+        BrokerWeakPtr broker;
+    };
+
+    // Number of records inspected per insertion. Inspecting more than one
+    // record per insertion guarantees that expired records are removed
+    // faster than new records are added.
+    static constexpr size_t _collectStep = 2;
+
+    std::deque<_Record> _records;
+    std::mutex _recordMutex;
+};
+
+}  // anonymous namespace
+
+Subscription::Subscription(std::function<void()> revoke)
+    : _revoke(std::move(revoke))
+{
+}
+
+Subscription::Subscription(Subscription&& other) noexcept
+    : _revoke(std::move(other._revoke))
+{
+    other._revoke = nullptr;
+}
+
+Subscription& Subscription::operator=(Subscription&& other) noexcept
+{
+    if (this != &other) {
+        Reset();
+        _revoke = std::move(other._revoke);
+        other._revoke = nullptr;
+    }
+    return *this;
+}
+
+void Subscription::Reset()
+{
+    if (!_revoke) return;
+
+    auto revoke = std::move(_revoke);
+    _revoke = nullptr;
+    revoke();
+}
+
+struct Broker::_SubscriberTable {
+    using _Callback = std::function<void(const UnfNotice::StageNotice&)>;
+
+    struct _Subscriber {
+        size_t id;
+        _Callback callback;
+    };
 
-Broker::Broker(const UsdStageWeakPtr& stage) : _stage(stage)
+    // Lists are never modified once recorded, so that they can be iterated
+    // without holding the lock while callbacks subscribe or unsubscribe.
+    using _SubscriberList = std::vector<_Subscriber>;
+    using _SubscriberListPtr = std::shared_ptr<const _SubscriberList>;
+
+    size_t Add(size_t index, _Callback callback)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+
+        if (index >= lists.size()) {
+            lists.resize(index + 1);
+        }
+
+        auto list = std::make_shared<_SubscriberList>();
+        if (lists[index]) *list = *lists[index];
+
+        size_t id = nextId++;
+        list->push_back({id, std::move(callback)});
+        lists[index] = std::move(list);
+
+        count.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    void Remove(size_t index, size_t id)
+    {
+        // Release callback once lock is released, as it might hold
+        // resources which subscribe or unsubscribe other callbacks.
+        _SubscriberListPtr previous;
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            if (index >= lists.size() || !lists[index]) return;
+
+            auto list = std::make_shared<_SubscriberList>();
+            for (const auto& subscriber : *lists[index]) {
+                if (subscriber.id != id) list->push_back(subscriber);
+            }
+
+            if (list->size() == lists[index]->size()) return;
+
+            previous = std::move(lists[index]);
+            lists[index] = list->empty() ? nullptr : std::move(list);
+            count.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    void Notify(const UnfNotice::StageNotice& notice) const
+    {
+        if (count.load(std::memory_order_relaxed) == 0) return;
+
+        _SubscriberListPtr list;
+        {
+            size_t index = notice.GetTypeIndex();
+
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            if (index >= lists.size()) return;
+            list = lists[index];
+        }
+
+        if (!list) return;
+
+        for (const auto& subscriber : *list) {
+            subscriber.callback(notice);
+        }
+    }
+
+    // Subscriber lists addressed by notice type index.
+    std::vector<_SubscriberListPtr> lists;
+    mutable std::shared_mutex mutex;
+
+    // Identifier assigned to the next callback subscribed.
+    size_t nextId = 0;
+
+    // Number of callbacks subscribed.
+    std::atomic<size_t> count{0};
+};
+
+struct Broker::_Recipients {
+    UsdStageWeakPtr stage;
+
+    // Indicate whether notices are sent as TfNotice.
+    bool tfNotice;
+
+    std::shared_ptr<_SubscriberTable> subscribers;
+
+    void Notify(const UnfNotice::StageNoticeRefPtr& notice) const
+    {
+        if (tfNotice) {
+            notice->Send(stage);
+        }
+
+        subscribers->Notify(*notice);
+    }
+};
+
+Broker::Broker(const UsdStageWeakPtr& stage)
+    : _stage(stage), _subscribers(std::make_shared<_SubscriberTable>())
 {
     // Add default dispatcher.
     _AddDispatcher<StageDispatcher>();
@@ -31,87 +351,729 @@ Broker::Broker(const UsdStageWeakPtr& stage) : _stage(stage)
     }
 }
 
+struct Broker::_ThreadLocalData {
+    // Transactions and notices captured by one thread.
+    struct _State {
+        // Stack of transactions, only accessed from the owning thread.
+        std::vector<_NoticeMerger> mergers;
+
+        // Mergers recycled, only accessed from the owning thread.
+        std::vector<_NoticeMerger> pool;
+
+        // Notices captured by the owning thread outside of its own
+        // transactions, to be collected by the last transaction closed.
+        _NoticeMerger buffer;
+        std::mutex mutex;
+
+        // Generation of capture settings applied to the buffer.
+        size_t generation = 0;
+
+        // Expires when the owning thread exits.
+        std::weak_ptr<bool> owner;
+    };
+
+    using _StatePtr = std::shared_ptr<_State>;
+
+    // Return state of the calling thread, and register it if necessary.
+    _State& GetLocal()
+    {
+        // States of the calling thread addressed by the data of each broker.
+        // States are only owned by the broker, so entries of expired brokers
+        // can be detected and are erased when a new entry is recorded.
+        thread_local std::unordered_map<
+            const _ThreadLocalData*,
+            std::weak_ptr<_State> >
+            locals;
+
+        // Token released when the calling thread exits.
+        thread_local auto token = std::make_shared<bool>(true);
+
+        auto& entry = locals[this];
+        if (auto state = entry.lock()) {
+            return *state;
+        }
+
+        for (auto it = locals.begin(); it != locals.end();) {
+            if (it->first != this && it->second.expired()) {
+                it = locals.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        auto state = std::make_shared<_State>();
+        state->owner = token;
+        entry = state;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        states.push_back(state);
+        return *state;
+    }
+
+    // Record thread starting its outermost transaction with \p predicate
+    // and \p scope. Notices sent from threads without transaction are
+    // captured with the settings of the first transaction started while no
+    // other transactions are started.
+    void Open(const CapturePredicate& predicate, const SdfPathVector& scope)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (count.load(std::memory_order_acquire) == 0) {
+            this->predicate = predicate;
+            this->scope = scope;
+            generation.fetch_add(1, std::memory_order_release);
+        }
+
+        count.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    // Apply capture settings of started transactions to the buffer of
+    // \p state, which must be locked.
+    void Configure(
+        _State& state, bool streaming, size_t parallelThreshold, size_t budget)
+    {
+        if (state.generation == generation.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        // Notices held in buffers are joined by the last transaction closed.
+        std::lock_guard<std::mutex> lock(mutex);
+        state.buffer.Configure(
+            predicate,
+            streaming,
+            parallelThreshold,
+            budget,
+            scope,
+            false,
+            true);
+        state.generation = generation.load(std::memory_order_acquire);
+    }
+
+    // Un-register states of threads which exited, once their notices have
+    // been collected.
+    void Prune()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        states.erase(
+            std::remove_if(
+                states.begin(),
+                states.end(),
+                [](const _StatePtr& state) { return state->owner.expired(); }),
+            states.end());
+    }
+
+    // All states registered, guarded by mutex.
+    std::vector<_StatePtr> states;
+    std::mutex mutex;
+
+    // Capture settings of started transactions, guarded by mutex.
+    CapturePredicate predicate = CapturePredicate::Default();
+    SdfPathVector scope;
+
+    // Incremented each time capture settings are recorded.
+    std::atomic<size_t> generation{0};
+
+    // Number of threads with at least one transaction started.
+    std::atomic<size_t> count{0};
+};
+
+Broker::~Broker()
+{
+    // Emit notices still batched, while dispatchers are registered.
+    _FlushAutoBatch();
+
+    // Revoke listeners while demand can still be updated, as dispatchers
+    // could outlive the broker.
+    for (auto& element : _dispatcherMap) {
+        element.second->Revoke();
+    }
+}
+
 BrokerPtr Broker::Create(const UsdStageWeakPtr& stage)
 {
-    Broker::_CleanCache();
+    auto& registry = _BrokerRegistry::GetInstance();
+
+    // Return existing broker without blocking concurrent lookups.
+    BrokerPtr broker = registry.Find(stage);
+    if (broker) return broker;
 
-    // If there doesn't exist a broker for the given stage, create a new broker.
-    if (Registry.find(stage) == Registry.end()) {
-        Registry[stage] = TfCreateRefPtr(new Broker(stage));
+    // If there doesn't exist a broker for the given stage, create a new broker
+    // without holding any lock.
+    BrokerPtr candidate = TfCreateRefPtr(new Broker(stage));
+
+    // Another broker might have been registered concurrently, in which case
+    // the new broker is dropped.
+    broker = registry.Insert(stage, candidate);
+    if (broker != candidate) return broker;
+
+    // Reclaim brokers targeting expired stages, a few at a time.
+    registry.Collect(stage, broker);
+
+    return broker;
+}
+
+bool Broker::IsInTransaction()
+{
+    if (_threadLocal) {
+        return _threadLocalData->count.load(std::memory_order_acquire) > 0;
     }
 
-    return Registry[stage];
+    return _mergers.size() > 0;
+}
+
+void Broker::SetStreamingMerge(bool enabled) { _streamingMerge = enabled; }
+
+void Broker::SetParallelThreshold(size_t threshold)
+{
+    _parallelThreshold = threshold;
 }
 
-bool Broker::IsInTransaction() { return _mergers.size() > 0; }
+void Broker::SetTransactionBudget(size_t budget)
+{
+    _transactionBudget = budget;
+}
+
+void Broker::SetThreadLocalTransactions(bool enabled)
+{
+    if (enabled == _threadLocal) return;
+
+    if (IsInTransaction()) {
+        TF_CODING_ERROR(
+            "Cannot change thread-local transactions while a transaction is "
+            "started.");
+        return;
+    }
+
+    if (enabled) {
+        _threadLocalData.reset(new _ThreadLocalData());
+    }
+    else {
+        _threadLocalData.reset();
+    }
+
+    _threadLocal = enabled;
+}
 
 void Broker::BeginTransaction(CapturePredicate predicate)
 {
-    _mergers.push_back(_NoticeMerger(predicate));
+    BeginTransaction(SdfPathVector(), std::move(predicate));
+}
+
+void Broker::BeginTransaction(
+    const SdfPathVector& scope, CapturePredicate predicate)
+{
+    auto& mergers = _GetMergers();
+
+    // Subtrees nested within other subtrees are redundant.
+    SdfPathVector prefixes(scope);
+    SdfPath::RemoveDescendentPaths(&prefixes);
+
+    // Nested transactions capturing notices identically to the current
+    // transaction are only counted.
+    if (mergers.size() > 0 &&
+        mergers.back().CanNest(predicate, _streamingMerge, prefixes)) {
+        mergers.back().Nest();
+        return;
+    }
+
+    // Record thread starting its outermost transaction.
+    if (_threadLocal && mergers.empty()) {
+        _threadLocalData->Open(predicate, prefixes);
+    }
+
+    _PushMerger(predicate, std::move(prefixes));
 }
 
 void Broker::BeginTransaction(const CapturePredicateFunc& function)
 {
-    _mergers.push_back(_NoticeMerger(CapturePredicate(function)));
+    BeginTransaction(CapturePredicate(function));
 }
 
 void Broker::EndTransaction()
 {
-    if (!IsInTransaction()) {
+    auto& mergers = _GetMergers();
+
+    if (mergers.empty()) {
         return;
     }
 
-    _NoticeMerger& merger = _mergers.back();
+    _NoticeMerger& merger = mergers.back();
+
+    // Close nested transaction collapsed into current merger.
+    if (merger.Unnest()) {
+        return;
+    }
+
+    // Evaluate batched predicate on all notices captured.
+    merger.Filter();
 
     // If there are only one merger left, process all notices.
-    if (_mergers.size() == 1) {
-        merger.Merge();
-        merger.PostProcess();
-        merger.Send(_stage);
+    if (mergers.size() == 1) {
+        if (_threadLocal) {
+            _EndThreadLocalTransaction(merger);
+        }
+        else if (_autoBatching) {
+            _AddToAutoBatch(merger);
+        }
+        // Skip consolidation entirely if no notices were captured.
+        else if (!merger.IsEmpty()) {
+            _Deliver(std::move(merger));
+        }
     }
     // Otherwise, it means that we are in a nested transaction that should
     // not be processed yet. Join data with next merger.
-    else {
-        (_mergers.end() - 2)->Join(merger);
+    else if (!merger.IsEmpty()) {
+        (mergers.end() - 2)->Join(merger);
     }
 
-    _mergers.pop_back();
+    _PopMerger();
 }
 
 void Broker::Send(const UnfNotice::StageNoticeRefPtr& notice)
 {
+    if (_threadLocal) {
+        auto& state = _threadLocalData->GetLocal();
+
+        if (state.mergers.size() > 0) {
+            _Capture(state.mergers, notice);
+            return;
+        }
+
+        // Capture notice within the buffer of the calling thread if a
+        // transaction is started on another thread. The count is checked
+        // while the buffer is locked to ensure that the notice is either
+        // collected by the last transaction closed or sent immediately.
+        {
+            auto& data = *_threadLocalData;
+
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if (data.count.load(std::memory_order_acquire) > 0) {
+                data.Configure(
+                    state,
+                    _streamingMerge,
+                    _parallelThreshold,
+                    _transactionBudget);
+                state.buffer.Add(notice);
+                return;
+            }
+        }
+
+        _SendNow(notice);
+        return;
+    }
+
     if (_mergers.size() > 0) {
-        _mergers.back().Add(notice);
+        _Capture(_mergers, notice);
+    }
+    else if (_autoBatching) {
+        _AddToAutoBatch(notice);
     }
     // Otherwise, send the notice.
     else {
-        notice->Send(_stage);
+        _SendNow(notice);
+    }
+}
+
+void Broker::SetAutoBatching(bool enabled)
+{
+    _autoBatching = enabled;
+
+    if (!enabled) {
+        _FlushAutoBatch();
+    }
+}
+
+void Broker::SetAutoBatchThreshold(size_t threshold)
+{
+    _autoBatchThreshold = threshold;
+}
+
+void Broker::SetAutoBatchInterval(double interval)
+{
+    _autoBatchInterval = interval;
+}
+
+void Broker::Tick() { _FlushAutoBatch(); }
+
+void Broker::SetExecutor(const ExecutorPtr& executor)
+{
+    if (executor == _executor) return;
+
+    // Ensure that notices are delivered in order when switching executor.
+    WaitForDelivery();
+
+    _executor = executor;
+}
+
+void Broker::WaitForDelivery()
+{
+    if (_executor) {
+        _executor->Wait();
+    }
+}
+
+void Broker::SetTfNoticeDelivery(bool enabled)
+{
+    _tfNoticeDelivery = enabled;
+}
+
+void Broker::SetDemandDriven(bool enabled)
+{
+    std::lock_guard<std::recursive_mutex> lock(_demandMutex);
+
+    if (_demandDriven == enabled) return;
+
+    _demandDriven = enabled;
+    _UpdateDispatchers();
+}
+
+Subscription Broker::_Subscribe(
+    size_t index, std::function<void(const UnfNotice::StageNotice&)> callback)
+{
+    size_t id = _subscribers->Add(index, std::move(callback));
+    _AddDemand(index);
+
+    // Handle can safely outlive the broker.
+    auto self = TfCreateWeakPtr(this);
+    std::weak_ptr<_SubscriberTable> subscribers = _subscribers;
+    return Subscription([self, subscribers, index, id]() {
+        if (auto table = subscribers.lock()) {
+            table->Remove(index, id);
+        }
+        if (self) {
+            self->_RemoveDemand(index);
+        }
+    });
+}
+
+Subscription Broker::_Demand(size_t index)
+{
+    _AddDemand(index);
+
+    // Handle can safely outlive the broker.
+    auto self = TfCreateWeakPtr(this);
+    return Subscription([self, index]() {
+        if (self) {
+            self->_RemoveDemand(index);
+        }
+    });
+}
+
+void Broker::_AddDemand(size_t index)
+{
+    std::lock_guard<std::recursive_mutex> lock(_demandMutex);
+
+    if (index >= _demand.size()) {
+        _demand.resize(index + 1, 0);
+    }
+
+    if (_demand[index]++ == 0 && _demandDriven) {
+        _UpdateDispatchers();
     }
 }
 
+void Broker::_RemoveDemand(size_t index)
+{
+    std::lock_guard<std::recursive_mutex> lock(_demandMutex);
+
+    if (index >= _demand.size() || _demand[index] == 0) {
+        TF_CODING_ERROR("No demand recorded for notice type.");
+        return;
+    }
+
+    if (--_demand[index] == 0 && _demandDriven) {
+        _UpdateDispatchers();
+    }
+}
+
+bool Broker::_IsInDemand(size_t index) const
+{
+    std::lock_guard<std::recursive_mutex> lock(_demandMutex);
+    return index < _demand.size() && _demand[index] > 0;
+}
+
+void Broker::_UpdateDispatchers()
+{
+    for (auto& element : _dispatcherMap) {
+        element.second->Update();
+    }
+}
+
+Broker::_Recipients Broker::_GetRecipients() const
+{
+    return _Recipients{_stage, _tfNoticeDelivery, _subscribers};
+}
+
+void Broker::_SendNow(const UnfNotice::StageNoticeRefPtr& notice)
+{
+    if (!_executor) {
+        _GetRecipients().Notify(notice);
+        return;
+    }
+
+    // Notice must not reference data from the notice it was created from
+    // once handed over to the executor.
+    notice->Materialize();
+
+    auto recipients = _GetRecipients();
+    _executor->Submit([notice, recipients]() { recipients.Notify(notice); });
+}
+
 DispatcherPtr& Broker::GetDispatcher(std::string identifier)
 {
     return _dispatcherMap.at(identifier);
 }
 
-void Broker::Reset() { Registry.erase(_stage); }
+void Broker::Reset() { _BrokerRegistry::GetInstance().Erase(_stage); }
+
+void Broker::ResetAll() { _BrokerRegistry::GetInstance().Clear(); }
 
-void Broker::ResetAll() { Registry.clear(); }
+std::vector<Broker::_NoticeMerger>& Broker::_GetMergers()
+{
+    if (_threadLocal) {
+        return _threadLocalData->GetLocal().mergers;
+    }
+
+    return _mergers;
+}
 
-void Broker::_CleanCache()
+std::vector<Broker::_NoticeMerger>& Broker::_GetMergerPool()
 {
-    for (auto it = Registry.begin(); it != Registry.end();) {
-        // If the stage doesn't exist anymore, delete the corresponding
-        // broker from the registry.
-        if (it->second->GetStage().IsExpired()) {
-            it = Registry.erase(it);
+    if (_threadLocal) {
+        return _threadLocalData->GetLocal().pool;
+    }
+
+    return _mergerPool;
+}
+
+void Broker::_Capture(
+    std::vector<_NoticeMerger>& mergers,
+    const UnfNotice::StageNoticeRefPtr& notice)
+{
+    // Notices captured by nested transactions are joined into enclosing
+    // transactions, so notices which any transaction started would reject
+    // are discarded as soon as they are captured. Enclosing transactions
+    // are evaluated first.
+    for (const auto& merger : mergers) {
+        if (!merger.Accept(*notice)) return;
+    }
+
+    // Captured notice must not reference data from the notice it was
+    // created from.
+    notice->Materialize();
+
+    // Trim notice to the subtrees in scope of each transaction, and discard
+    // it if nothing is left. A copy is trimmed if the notice is also held by
+    // the sender, so that the sender does not observe it modified.
+    bool shared = notice->GetCurrentCount() > 1;
+    UnfNotice::StageNoticeRefPtr captured = notice;
+
+    for (const auto& merger : mergers) {
+        const auto& scope = merger.GetScope();
+        if (scope.empty()) continue;
+
+        if (shared) {
+            captured = notice->Clone();
+            shared = false;
         }
-        else {
-            it++;
+
+        if (!captured->Restrict(scope)) return;
+    }
+
+    mergers.back().Hold(captured);
+}
+
+void Broker::_PushMerger(
+    const CapturePredicate& predicate, SdfPathVector scope)
+{
+    auto& mergers = _GetMergers();
+    auto& pool = _GetMergerPool();
+
+    // Notices must be held separately until batched predicates of enclosing
+    // transactions are evaluated, so that they are evaluated on the notices
+    // captured rather than on merged notices.
+    bool batchedAncestor =
+        mergers.size() > 0 && mergers.back().IsMergeDeferred();
+
+    // Notices are joined into the enclosing transaction, the buffer of the
+    // calling thread or the auto-batch when the transaction ends.
+    bool joined = mergers.size() > 0 || _threadLocal || _autoBatching;
+
+    if (pool.empty()) {
+        mergers.push_back(_NoticeMerger(
+            predicate,
+            _streamingMerge,
+            _parallelThreshold,
+            _transactionBudget,
+            std::move(scope),
+            batchedAncestor,
+            joined));
+    }
+    else {
+        mergers.push_back(std::move(pool.back()));
+        pool.pop_back();
+
+        mergers.back().Configure(
+            predicate,
+            _streamingMerge,
+            _parallelThreshold,
+            _transactionBudget,
+            std::move(scope),
+            batchedAncestor,
+            joined);
+    }
+}
+
+void Broker::_PopMerger()
+{
+    auto& mergers = _GetMergers();
+    auto& pool = _GetMergerPool();
+
+    // Notices still held are released before the merger is recycled, as
+    // merger delivered synchronously are consolidated in place.
+    mergers.back().Clear();
+
+    if (pool.size() < _maxMergerPoolSize) {
+        pool.push_back(std::move(mergers.back()));
+    }
+
+    mergers.pop_back();
+}
+
+void Broker::_EndThreadLocalTransaction(_NoticeMerger& merger)
+{
+    auto& data = *_threadLocalData;
+
+    // Hold notices within the buffer of the calling thread before closing
+    // its outermost transaction, so that they can be collected.
+    {
+        auto& state = data.GetLocal();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.buffer.Join(merger);
+    }
+
+    // Only the last transaction closed across all threads emits notices.
+    if (data.count.fetch_sub(1, std::memory_order_acq_rel) > 1) {
+        return;
+    }
+
+    std::vector<_ThreadLocalData::_StatePtr> states;
+    {
+        std::lock_guard<std::mutex> lock(data.mutex);
+        states = data.states;
+    }
+
+    // Notices held in buffers were already evaluated when captured.
+    _NoticeMerger collector(
+        CapturePredicate::Default(),
+        _streamingMerge,
+        _parallelThreshold,
+        _transactionBudget);
+
+    for (const auto& state : states) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        collector.Join(state->buffer);
+    }
+
+    data.Prune();
+
+    _Deliver(std::move(collector));
+}
+
+void Broker::_AddToAutoBatch(_NoticeMerger& merger)
+{
+    // Skip transactions without notices so that the batch interval is only
+    // measured from the first notice captured.
+    if (merger.IsEmpty()) return;
+
+    _GetAutoBatch().Join(merger);
+    _UpdateAutoBatch();
+}
+
+void Broker::_AddToAutoBatch(const UnfNotice::StageNoticeRefPtr& notice)
+{
+    _GetAutoBatch().Add(notice);
+    _UpdateAutoBatch();
+}
+
+Broker::_NoticeMerger& Broker::_GetAutoBatch()
+{
+    if (!_autoBatch) {
+        _autoBatch.reset(new _NoticeMerger(
+            CapturePredicate::Default(),
+            _streamingMerge,
+            _parallelThreshold,
+            _transactionBudget));
+        _autoBatchStart = std::chrono::steady_clock::now();
+    }
+
+    return *_autoBatch;
+}
+
+void Broker::_UpdateAutoBatch()
+{
+    if (_autoBatchThreshold > 0 &&
+        _autoBatch->GetCount() >= _autoBatchThreshold) {
+        _FlushAutoBatch();
+        return;
+    }
+
+    if (_autoBatchInterval > 0) {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - _autoBatchStart;
+
+        if (elapsed.count() >= _autoBatchInterval) {
+            _FlushAutoBatch();
         }
     }
 }
 
+void Broker::_FlushAutoBatch()
+{
+    if (!_autoBatch) return;
+
+    // Release batch before delivery, as listeners might send new notices.
+    std::unique_ptr<_NoticeMerger> batch = std::move(_autoBatch);
+    _Deliver(std::move(*batch));
+}
+
+void Broker::_Deliver(_NoticeMerger&& merger)
+{
+    merger.Prioritize(_priorities);
+
+    if (!_executor) {
+        merger.Merge();
+        merger.PostProcess();
+        merger.Send(_GetRecipients());
+        return;
+    }
+
+    // Notices are consolidated on the executor as well.
+    auto _merger = std::make_shared<_NoticeMerger>(std::move(merger));
+    auto recipients = _GetRecipients();
+
+    _executor->Submit([_merger, recipients]() {
+        _merger->Merge();
+        _merger->PostProcess();
+        _merger->Send(recipients);
+    });
+}
+
+int Broker::_GetPriority(size_t index) const
+{
+    if (index >= _priorities.size()) return 0;
+    return _priorities[index];
+}
+
+void Broker::_SetPriority(size_t index, int priority)
+{
+    if (index >= _priorities.size()) {
+        _priorities.resize(index + 1, 0);
+    }
+    _priorities[index] = priority;
+}
+
 void Broker::_DiscoverDispatchers()
 {
     TfType root = TfType::Find<Dispatcher>();
@@ -128,78 +1090,468 @@ void Broker::_Add(const DispatcherPtr& dispatcher)
     _dispatcherMap[dispatcher->GetIdentifier()] = dispatcher;
 }
 
-Broker::_NoticeMerger::_NoticeMerger(CapturePredicate predicate)
-    : _predicate(std::move(predicate))
+Broker::_NoticeMerger::_NoticeMerger(
+    CapturePredicate predicate,
+    bool streaming,
+    size_t parallelThreshold,
+    size_t budget,
+    SdfPathVector scope,
+    bool batchedAncestor,
+    bool joined)
+    : _predicate(std::move(predicate)),
+      _scope(std::move(scope)),
+      _streaming(streaming),
+      _batched(_predicate.IsBatched()),
+      _batchedAncestor(batchedAncestor),
+      _joined(joined),
+      _parallelThreshold(parallelThreshold),
+      _budget(budget)
+{
+}
+
+void Broker::_NoticeMerger::Configure(
+    CapturePredicate predicate,
+    bool streaming,
+    size_t parallelThreshold,
+    size_t budget,
+    SdfPathVector scope,
+    bool batchedAncestor,
+    bool joined)
+{
+    _predicate = std::move(predicate);
+    _batched = _predicate.IsBatched();
+    _batchedAncestor = batchedAncestor;
+    _joined = joined;
+    _scope = std::move(scope);
+    _streaming = streaming;
+    _parallelThreshold = parallelThreshold;
+    _budget = budget;
+}
+
+void Broker::_NoticeMerger::Clear()
+{
+    for (auto& notices : _noticeTable) {
+        notices.clear();
+
+        // Release large lists so that recycled mergers remain small.
+        if (notices.capacity() > _maxClearedCapacity) {
+            _NoticePtrList().swap(notices);
+        }
+    }
+
+    _order.clear();
+    _parallel = false;
+    _spent = 0;
+    _depth = 0;
+}
+
+bool Broker::_NoticeMerger::CanNest(
+    const CapturePredicate& predicate,
+    bool streaming,
+    const SdfPathVector& scope) const
+{
+    if (streaming != _streaming) return false;
+
+    // Enclosing predicates and scopes are applied to notices captured by
+    // nested transactions, so a nested transaction without predicate nor
+    // scope captures the same notices as this merger.
+    if (predicate.IsDefault() && scope.empty()) return true;
+
+    return predicate == _predicate && scope == _scope;
+}
+
+bool Broker::_NoticeMerger::Unnest()
+{
+    if (_depth == 0) return false;
+
+    _depth -= 1;
+    return true;
+}
+
+bool Broker::_NoticeMerger::Accept(const UnfNotice::StageNotice& notice) const
 {
+    // Batched predicates are only evaluated when the transaction ends.
+    return _batched || _predicate(notice);
 }
 
 void Broker::_NoticeMerger::Add(const UnfNotice::StageNoticeRefPtr& notice)
 {
-    // Indicate whether the notice needs to be captured.
+    // Indicate whether the notice needs to be captured. Batched predicates
+    // are evaluated immediately as notices added are never filtered.
     if (!_predicate(*notice)) return;
 
-    // Store notices per type name, so that each type can be merged if
+    // Captured notice must not reference data from the notice it was
+    // created from.
+    notice->Materialize();
+
+    if (_scope.empty()) {
+        Hold(notice);
+        return;
+    }
+
+    // Trim notice to the subtrees in scope, and discard it if nothing is
+    // left. A copy is trimmed if the notice is also held by the sender, so
+    // that the sender does not observe it modified.
+    auto captured =
+        notice->GetCurrentCount() > 1 ? notice->Clone() : notice;
+    if (!captured->Restrict(_scope)) return;
+
+    Hold(captured);
+}
+
+void Broker::_NoticeMerger::Hold(const UnfNotice::StageNoticeRefPtr& notice)
+{
+    // Store notices per type index, so that each type can be merged if
     // required.
-    std::string name = notice->GetTypeId();
-    _noticeMap[name].push_back(notice);
+    size_t index = notice->GetTypeIndex();
+    if (index >= _noticeTable.size()) {
+        _noticeTable.resize(index + 1);
+    }
+
+    // Record order in which notice types are first captured.
+    if (_noticeTable[index].empty()) {
+        _order.push_back(index);
+    }
+
+    _Append(_noticeTable[index], notice);
+    _Spend(1);
 }
 
 void Broker::_NoticeMerger::Join(_NoticeMerger& merger)
 {
-    for (auto& element : merger._noticeMap) {
-        auto& source = element.second;
-        auto& target = _noticeMap[element.first];
+    if (merger._noticeTable.size() > _noticeTable.size()) {
+        _noticeTable.resize(merger._noticeTable.size());
+    }
 
-        target.reserve(target.size() + source.size());
-        std::move(
-            std::begin(source), std::end(source), std::back_inserter(target));
+    size_t count = 0;
+
+    // Notice types are visited in the order in which they were first
+    // captured by the incoming merger.
+    for (size_t index : merger._order) {
+        auto& source = merger._noticeTable[index];
+        auto& target = _noticeTable[index];
+
+        if (source.empty()) continue;
+
+        count += source.size();
+
+        if (target.empty()) {
+            _order.push_back(index);
+        }
+
+        if (_streaming) {
+            for (const auto& notice : source) {
+                _Append(target, notice);
+            }
+        }
+        // Splice list if no notices were captured for this type.
+        else if (target.empty()) {
+            target.swap(source);
+        }
+        else {
+            // Notices with associative merge can be merged before being
+            // joined, so that only one notice is moved. As they follow the
+            // notices held, they are prepared as within a reduction so that
+            // the result is identical to a sequential merge. Notices must
+            // be held separately until a batched predicate is evaluated.
+            if (!IsMergeDeferred() && source[0]->IsMergeable() &&
+                source[0]->IsMergeAssociative()) {
+                for (auto& notice : source) {
+                    notice->PrepareReduce();
+                }
+                _Merge(source);
+            }
+
+            target.reserve(target.size() + source.size());
+            std::move(
+                std::begin(source),
+                std::end(source),
+                std::back_inserter(target));
+        }
 
         source.clear();
     }
 
-    merger._noticeMap.clear();
+    // Lists of incoming merger are kept to be recycled.
+    merger._order.clear();
+    _Spend(count);
+}
+
+void Broker::_NoticeMerger::Filter()
+{
+    if (!_batched || _order.empty()) return;
+
+    // Gather notices in the order in which they would be sent, so that the
+    // predicate is evaluated once for all notices held.
+    _NoticePtrList notices;
+    notices.reserve(GetCount());
+
+    for (size_t index : _order) {
+        auto& source = _noticeTable[index];
+        std::move(source.begin(), source.end(), std::back_inserter(notices));
+        source.clear();
+    }
+
+    _predicate.Filter(notices);
+
+    for (auto& notice : notices) {
+        _noticeTable[notice->GetTypeIndex()].push_back(std::move(notice));
+    }
+
+    // Types without notices left are removed from the order.
+    _order.erase(
+        std::remove_if(
+            _order.begin(),
+            _order.end(),
+            [&](size_t index) { return _noticeTable[index].empty(); }),
+        _order.end());
+}
+
+size_t Broker::_NoticeMerger::GetCount() const
+{
+    size_t count = 0;
+    for (const auto& notices : _noticeTable) {
+        count += notices.size();
+    }
+    return count;
+}
+
+void Broker::_NoticeMerger::Prioritize(const std::vector<int>& priorities)
+{
+    if (priorities.empty()) return;
+
+    auto priority = [&](size_t index) {
+        return index < priorities.size() ? priorities[index] : 0;
+    };
+
+    std::stable_sort(_order.begin(), _order.end(), [&](size_t a, size_t b) {
+        return priority(a) > priority(b);
+    });
 }
 
 void Broker::_NoticeMerger::Merge()
 {
-    for (auto& element : _noticeMap) {
-        auto& notices = element.second;
-
-        // If there are more than one notice for this type and
-        // if the notices are mergeable, we only need to keep the
-        // first notice, and all other can be pruned.
-        if (notices.size() > 1 && notices[0]->IsMergeable()) {
-            auto& notice = notices.at(0);
-            auto it = std::next(notices.begin());
-
-            while (it != notices.end()) {
-                // Attempt to merge content of notice with first notice
-                // if this is possible.
-                notice->Merge(std::move(**it));
-                it = notices.erase(it);
+    // Decide once as merging reduces the number of notices held.
+    _parallel = _ShouldRunParallel();
+
+    // Notices of distinct types are independent from each other, so each
+    // type can be merged within a separate task.
+    if (_parallel) {
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, _noticeTable.size(), 1),
+            [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t index = range.begin(); index != range.end();
+                     ++index) {
+                    _Merge(_noticeTable[index]);
+                }
+            });
+        return;
+    }
+
+    for (auto& notices : _noticeTable) {
+        _Merge(notices);
+    }
+}
+
+void Broker::_NoticeMerger::PostProcess()
+{
+    if (_parallel) {
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, _noticeTable.size(), 1),
+            [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t index = range.begin(); index != range.end();
+                     ++index) {
+                    auto& notices = _noticeTable[index];
+                    if (notices.empty()) continue;
+
+                    notices[0]->PostProcess();
+                }
+            });
+        return;
+    }
+
+    for (auto& notices : _noticeTable) {
+        if (notices.empty()) continue;
+
+        notices[0]->PostProcess();
+    }
+}
+
+void Broker::_NoticeMerger::Send(const _Recipients& recipients)
+{
+    for (size_t index : _order) {
+        // Send all remaining notices.
+        for (const auto& notice : _noticeTable[index]) {
+            recipients.Notify(notice);
+        }
+    }
+}
+
+void Broker::_NoticeMerger::_Append(
+    _NoticePtrList& notices, const UnfNotice::StageNoticeRefPtr& notice)
+{
+    // Fold notice into the first notice captured for this type so that
+    // only one notice is held per mergeable type, or into the second one if
+    // notices are joined into another merger. Notices must be held
+    // separately until a batched predicate is evaluated.
+    size_t first = _joined ? 1 : 0;
+
+    if (_streaming && !IsMergeDeferred() && !notices.empty() &&
+        notices[0]->IsMergeable()) {
+        // Skip notice which was sent several times.
+        if (notices[0] == notice) return;
+
+        if (notices.size() > first) {
+            auto& target = notices[first];
+            if (target != notice) {
+                if (_joined) {
+                    target->PrepareReduce();
+                }
+                target->Merge(std::move(*notice));
             }
+            return;
         }
     }
+
+    notices.push_back(notice);
 }
 
-void Broker::_NoticeMerger::PostProcess()
+void Broker::_NoticeMerger::_Merge(_NoticePtrList& notices, size_t first)
 {
-    for (auto& element : _noticeMap) {
-        auto& notice = element.second[0];
-        notice->PostProcess();
+    // If there are more than one notice for this type and
+    // if the notices are mergeable, we only need to keep the
+    // first notice, and all other can be pruned.
+    if (first > 0 && notices.size() > first + 1) {
+        // Notices sent several times are only merged once, so later copies
+        // of the first notice kept as captured can be discarded.
+        auto head = notices[0];
+        notices.erase(
+            std::remove(std::next(notices.begin()), notices.end(), head),
+            notices.end());
+    }
+
+    if (notices.size() > first + 1 && notices[0]->IsMergeable()) {
+        // Notices following the first one kept are prepared as within a
+        // reduction before being folded into.
+        if (first > 0) {
+            notices[first]->PrepareReduce();
+        }
+
+        // Large lists of associative notices are reduced concurrently.
+        if (_parallelThreshold > 0 && notices.size() >= _parallelThreshold &&
+            notices[0]->IsMergeAssociative()) {
+            _Reduce(notices, first);
+            return;
+        }
+
+        auto& notice = notices.at(first);
+
+        for (auto it = std::next(notices.begin(), first + 1);
+             it != notices.end();
+             ++it) {
+            // Skip notice which was sent several times.
+            if (*it == notice) continue;
+
+            notice->Merge(std::move(**it));
+        }
+
+        // Prune all merged notices at once.
+        notices.resize(first + 1);
     }
 }
 
-void Broker::_NoticeMerger::Send(const UsdStageWeakPtr& stage)
+void Broker::_NoticeMerger::_Reduce(_NoticePtrList& notices, size_t first)
 {
-    for (auto& element : _noticeMap) {
-        auto& notices = element.second;
+    using UnfNotice::StageNotice;
 
-        // Send all remaining notices.
-        for (const auto& notice : element.second) {
-            notice->Send(stage);
+    // Skip notices which were sent several times, so that each notice is
+    // merged exactly once whichever partial result it is merged into.
+    std::vector<StageNotice*> unique;
+    unique.reserve(notices.size() - first);
+
+    std::unordered_set<StageNotice*> visited;
+    visited.reserve(notices.size() - first);
+
+    for (auto it = std::next(notices.begin(), first); it != notices.end();
+         ++it) {
+        if (visited.insert(get_pointer(*it)).second) {
+            unique.push_back(get_pointer(*it));
         }
     }
+
+    // Each partial result is accumulated into the first notice of its range,
+    // and partial results are joined from left to right to preserve the
+    // order of notices.
+    StageNotice* result = tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(1, unique.size()),
+        static_cast<StageNotice*>(nullptr),
+        [&](const tbb::blocked_range<size_t>& range, StageNotice* partial) {
+            for (size_t index = range.begin(); index != range.end();
+                 ++index) {
+                unique[index]->PrepareReduce();
+
+                if (!partial) {
+                    partial = unique[index];
+                }
+                else {
+                    partial->Merge(std::move(*unique[index]));
+                }
+            }
+            return partial;
+        },
+        [](StageNotice* left, StageNotice* right) {
+            if (!left) return right;
+            if (!right) return left;
+
+            left->Merge(std::move(*right));
+            return left;
+        });
+
+    if (result) {
+        unique[0]->Merge(std::move(*result));
+    }
+
+    // Prune all merged notices at once.
+    notices.resize(first + 1);
+}
+
+void Broker::_NoticeMerger::_Spend(size_t count)
+{
+    // Notices are already consolidated as they are captured when merging
+    // is streamed, and must be held separately until a batched predicate is
+    // evaluated.
+    if (_budget == 0 || _streaming || IsMergeDeferred()) return;
+
+    _spent += count;
+    if (_spent < _budget) return;
+
+    // Merging in place preserves the order in which notices are folded, so
+    // the notices emitted at the end of the transaction are unchanged. The
+    // first notice of each type is kept as captured if notices are joined
+    // into another merger.
+    for (auto& notices : _noticeTable) {
+        _Merge(notices, _joined ? 1 : 0);
+    }
+
+    _spent = 0;
+}
+
+bool Broker::_NoticeMerger::_ShouldRunParallel() const
+{
+    if (_parallelThreshold == 0) return false;
+
+    size_t types = 0;
+    size_t count = 0;
+
+    for (const auto& notices : _noticeTable) {
+        if (notices.empty()) continue;
+
+        types += 1;
+        count += notices.size();
+    }
+
+    // Tasks are only worth spawning for several notice types.
+    return types > 1 && count >= _parallelThreshold;
 }
 
 }  // namespace unf
@@ -5,6 +5,7 @@
 
 #include "unf/api.h"
 #include "unf/capturePredicate.h"
+#include "unf/executor.h"
 #include "unf/notice.h"
 
 #include <pxr/base/plug/plugin.h>
@@ -14,11 +15,14 @@
 #include <pxr/base/tf/weakBase.h>
 #include <pxr/base/tf/weakPtr.h>
 #include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usd/common.h>
 #include <pxr/usd/usd/stage.h>
 
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <typeinfo>
 #include <unordered_map>
@@ -38,6 +42,42 @@ using BrokerWeakPtr = PXR_NS::TfWeakPtr<Broker>;
 /// Convenient alias for Dispatcher reference pointer.
 using DispatcherPtr = PXR_NS::TfRefPtr<Dispatcher>;
 
+/// \class Subscription
+///
+/// \brief
+/// Handle to a callback subscribed to notices emitted by a broker.
+///
+/// The callback is unsubscribed when the handle is reset or destroyed.
+///
+/// \sa Broker::Subscribe
+class Subscription {
+  public:
+    UNF_API Subscription() = default;
+
+    /// Create handle which calls \p revoke to unsubscribe callback.
+    UNF_API explicit Subscription(std::function<void()> revoke);
+
+    UNF_API ~Subscription() { Reset(); }
+
+    UNF_API Subscription(Subscription&&) noexcept;
+    UNF_API Subscription& operator=(Subscription&&) noexcept;
+
+    /// Remove default copy constructor.
+    UNF_API Subscription(const Subscription&) = delete;
+
+    /// Remove default assignment operator.
+    UNF_API Subscription& operator=(const Subscription&) = delete;
+
+    /// Indicate whether the handle holds a subscribed callback.
+    UNF_API bool IsValid() const { return bool(_revoke); }
+
+    /// Unsubscribe callback.
+    UNF_API void Reset();
+
+  private:
+    std::function<void()> _revoke;
+};
+
 /// \class Broker
 ///
 /// \brief
@@ -50,9 +90,14 @@ class Broker : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
     ///
     /// If a broker has already been created from this \p stage, it will be
     /// returned. Otherwise, a new one will be created and returned.
+    ///
+    /// \note
+    /// Brokers can be created concurrently from several threads. Brokers
+    /// are registered within shards so that retrieving an existing broker
+    /// only acquires a shared lock on the shard associated with \p stage.
     UNF_API static BrokerPtr Create(const PXR_NS::UsdStageWeakPtr& stage);
 
-    UNF_API virtual ~Broker() = default;
+    UNF_API virtual ~Broker();
 
     /// Remove default copy constructor.
     UNF_API Broker(const Broker&) = delete;
@@ -65,7 +110,14 @@ class Broker : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
 
     /// \brief
     /// Indicate whether a notice transaction has been started.
+    ///
+    /// \note
+    /// When transactions are local to each thread, this method indicates
+    /// whether a transaction has been started on any thread, as notices sent
+    /// from the calling thread would then be captured.
+    ///
     /// \sa BeginTransaction
+    /// \sa SetThreadLocalTransactions
     UNF_API bool IsInTransaction();
 
     /// \brief
@@ -79,6 +131,11 @@ class Broker : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
     /// influence which notices are captured. Notices that are not captured
     /// will not be emitted.
     ///
+    /// \note
+    /// Predicates of enclosing transactions also apply to nested
+    /// transactions, so notices rejected by any transaction started are
+    /// discarded as soon as they are captured.
+    ///
     /// \warning
     /// Each transaction started must be closed with EndTransaction.
     /// It is preferrable to use NoticeTransaction over this API to safely
@@ -110,6 +167,32 @@ class Broker : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
     /// \sa NoticeTransaction
     UNF_API void BeginTransaction(const CapturePredicateFunc&);
 
+    /// \brief
+    /// Start a notice transaction restricted to a set of subtrees.
+    ///
+    /// Captured notices are trimmed to the content under \p scope before
+    /// being held, so that changes outside of the subtrees are neither
+    /// stored nor merged. Notices with no content left are discarded.
+    ///
+    /// \code{.cpp}
+    /// broker->BeginTransaction({pxr::SdfPath("/World/Character")});
+    /// \endcode
+    ///
+    /// \note
+    /// Only UnfNotice::ObjectsChanged notices carry content which can be
+    /// trimmed, other notices are captured as usual.
+    ///
+    /// \warning
+    /// Each transaction started must be closed with EndTransaction.
+    /// It is preferrable to use NoticeTransaction over this API to safely
+    /// manage transactions.
+    ///
+    /// \sa EndTransaction
+    /// \sa UnfNotice::StageNotice::Restrict
+    UNF_API void BeginTransaction(
+        const PXR_NS::SdfPathVector& scope,
+        CapturePredicate predicate = CapturePredicate::Default());
+
     /// \brief
     /// Stop a notice transaction.
     ///
@@ -125,6 +208,318 @@ class Broker : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
     /// \sa NoticeTransaction
     UNF_API void EndTransaction();
 
+    /// \brief
+    /// Indicate whether mergeable notices are consolidated as soon as they
+    /// are captured.
+    /// \sa SetStreamingMerge
+    UNF_API bool IsStreamingMerge() const { return _streamingMerge; }
+
+    /// \brief
+    /// Set whether mergeable notices are consolidated as soon as they are
+    /// captured.
+    ///
+    /// By default, all notices captured during a transaction are held until
+    /// the end of the outermost transaction and consolidated at once. When
+    /// streaming is enabled, each mergeable notice is folded into the notice
+    /// previously captured for the same type, so that memory usage is bounded
+    /// by the number of notice types rather than by the number of notices.
+    ///
+    /// \note
+    /// This setting only affects transactions started after this call.
+    UNF_API void SetStreamingMerge(bool enabled);
+
+    /// \brief
+    /// Return minimum number of notices held at the end of a transaction
+    /// from which notice types are merged and post-processed concurrently.
+    /// \sa SetParallelThreshold
+    UNF_API size_t GetParallelThreshold() const { return _parallelThreshold; }
+
+    /// \brief
+    /// Set minimum number of notices held at the end of a transaction from
+    /// which notice types are merged and post-processed concurrently.
+    ///
+    /// By default, notices are consolidated one type after another on the
+    /// thread which ends the outermost transaction. When the number of
+    /// notices held reaches \p threshold, each notice type is consolidated
+    /// within a separate task. Lists of notices reaching \p threshold for a
+    /// type declaring an associative merge are also reduced concurrently.
+    /// A threshold of 0 disables concurrent processing.
+    ///
+    /// \sa UnfNotice::StageNotice::IsMergeAssociative
+    ///
+    /// \warning
+    /// Custom notices must not depend on the order in which notice types are
+    /// merged and post-processed when concurrent processing is enabled.
+    ///
+    /// \note
+    /// This setting only affects transactions started after this call.
+    UNF_API void SetParallelThreshold(size_t threshold);
+
+    /// \brief
+    /// Return number of notices captured within a transaction after which
+    /// mergeable notices are consolidated.
+    /// \sa SetTransactionBudget
+    UNF_API size_t GetTransactionBudget() const { return _transactionBudget; }
+
+    /// \brief
+    /// Set number of notices captured within a transaction after which
+    /// mergeable notices are consolidated.
+    ///
+    /// Each time \p budget notices are captured within a transaction,
+    /// mergeable notices held for each type are folded into the first notice
+    /// held for this type, so that memory usage of long transactions remains
+    /// bounded. Within nested transactions, the first notice is kept as
+    /// captured and following notices are folded into the second one. As
+    /// notices are merged in the order they were captured, the notices
+    /// emitted at the end of the transaction are identical. A budget of 0
+    /// disables early consolidation.
+    ///
+    /// \note
+    /// Notices which are not mergeable are kept until the end of the
+    /// transaction.
+    ///
+    /// \note
+    /// This setting only affects transactions started after this call.
+    UNF_API void SetTransactionBudget(size_t budget);
+
+    /// \brief
+    /// Return priority of notices of type \p UnfNotice emitted at the end of
+    /// a transaction.
+    /// \sa SetPriority
+    template <class UnfNotice>
+    int GetPriority() const;
+
+    /// \brief
+    /// Set priority of notices of type \p UnfNotice emitted at the end of a
+    /// transaction.
+    ///
+    /// Notices consolidated at the end of a transaction are emitted in
+    /// decreasing order of priority, so that cheap notices can reach
+    /// listeners before expensive ones. Notice types with identical
+    /// priorities are emitted in the order in which they were first
+    /// captured. The default priority is 0.
+    template <class UnfNotice>
+    void SetPriority(int priority);
+
+    /// \brief
+    /// Indicate whether each thread keeps its own stack of transactions.
+    /// \sa SetThreadLocalTransactions
+    UNF_API bool IsThreadLocalTransactions() const { return _threadLocal; }
+
+    /// \brief
+    /// Set whether each thread keeps its own stack of transactions.
+    ///
+    /// By default, transactions are shared between all threads, so the
+    /// broker must not be used from several threads at once. When enabled,
+    /// each thread keeps its own stack of transactions and capture buffer,
+    /// so that notices can be sent and captured concurrently without a
+    /// global lock.
+    ///
+    /// Notices sent from a thread without transaction while a transaction is
+    /// started on another thread are captured within a buffer local to the
+    /// sending thread, using the capture predicate and scope of the first
+    /// transaction started while no other transactions were started. Notices
+    /// captured by a thread which closes its outermost transaction while
+    /// transactions are still started on other threads are held within its
+    /// buffer as well. When the last transaction started across all threads
+    /// is closed, notices from all buffers are consolidated and emitted from
+    /// the thread which closed it.
+    ///
+    /// \warning
+    /// This setting cannot be changed while a transaction is started.
+    UNF_API void SetThreadLocalTransactions(bool enabled);
+
+    /// \brief
+    /// Return executor delivering notices asynchronously, or a null pointer
+    /// if notices are delivered synchronously.
+    /// \sa SetExecutor
+    UNF_API const ExecutorPtr& GetExecutor() const { return _executor; }
+
+    /// \brief
+    /// Set executor delivering notices asynchronously.
+    ///
+    /// By default, captured notices are consolidated and emitted by
+    /// EndTransaction, which blocks until all listeners have received them.
+    /// When an \p executor is set, notices captured are handed over to the
+    /// executor at the end of the outermost transaction, which then returns
+    /// immediately. Notices sent outside of transactions are also handed
+    /// over to the executor, so that all notices are delivered in the order
+    /// in which they were emitted.
+    ///
+    /// Passing a null pointer restores synchronous delivery once notices
+    /// handed over to the previous executor have been delivered.
+    ///
+    /// \warning
+    /// Listeners will receive notices from the thread used by the executor,
+    /// and must not assume that the stage is left unchanged.
+    ///
+    /// \sa ThreadExecutor
+    UNF_API void SetExecutor(const ExecutorPtr& executor);
+
+    /// \brief
+    /// Block until all notices handed over to the executor have been
+    /// delivered.
+    ///
+    /// Return immediately if notices are delivered synchronously.
+    UNF_API void WaitForDelivery();
+
+    /// \brief
+    /// Indicate whether notices are batched outside of transactions.
+    /// \sa SetAutoBatching
+    UNF_API bool IsAutoBatching() const { return _autoBatching; }
+
+    /// \brief
+    /// Set whether notices are batched outside of transactions.
+    ///
+    /// By default, notices sent outside of transactions are emitted
+    /// immediately. When enabled, these notices are captured within an
+    /// implicit batch, and notices captured by outermost transactions are
+    /// added to it as well. The batch is consolidated and emitted when Tick
+    /// is called, when the number of notices batched reaches the threshold
+    /// set with SetAutoBatchThreshold, or when a notice is added after the
+    /// interval set with SetAutoBatchInterval has elapsed.
+    ///
+    /// Disabling auto-batching or destroying the broker emits notices
+    /// currently batched.
+    ///
+    /// \note
+    /// Auto-batching is not applied when transactions are local to each
+    /// thread.
+    ///
+    /// \sa Tick
+    UNF_API void SetAutoBatching(bool enabled);
+
+    /// \brief
+    /// Return maximum number of notices batched before being emitted, or 0
+    /// if unlimited.
+    /// \sa SetAutoBatchThreshold
+    UNF_API size_t GetAutoBatchThreshold() const { return _autoBatchThreshold; }
+
+    /// \brief
+    /// Set maximum number of notices batched before being emitted.
+    ///
+    /// \note
+    /// When merging is streamed, mergeable notices of the same type are
+    /// counted once.
+    ///
+    /// A \p threshold of 0 indicates that the number of notices batched is
+    /// unlimited, which is the default.
+    UNF_API void SetAutoBatchThreshold(size_t threshold);
+
+    /// \brief
+    /// Return interval in seconds after which batched notices are emitted,
+    /// or 0 if unlimited.
+    /// \sa SetAutoBatchInterval
+    UNF_API double GetAutoBatchInterval() const { return _autoBatchInterval; }
+
+    /// \brief
+    /// Set interval in seconds after which batched notices are emitted.
+    ///
+    /// The interval is measured from the first notice batched, and is only
+    /// checked when a notice is added to the batch. Tick should be called
+    /// to ensure that notices are emitted at regular intervals.
+    ///
+    /// An \p interval of 0 indicates that notices can be batched for an
+    /// unlimited amount of time, which is the default.
+    UNF_API void SetAutoBatchInterval(double interval);
+
+    /// \brief
+    /// Emit notices batched since last call.
+    ///
+    /// This method is expected to be called at frame boundaries by the host
+    /// application, so that listeners receive consolidated notices at most
+    /// once per frame regardless of the edit rate.
+    ///
+    /// \sa SetAutoBatching
+    UNF_API void Tick();
+
+    /// \brief
+    /// Subscribe \p callback to notices of type \p T emitted by the broker.
+    ///
+    /// Callbacks are recorded per notice type within the broker and invoked
+    /// directly when a notice is emitted, without going through the
+    /// registry of PXR_NS::TfNotice listeners. Callbacks are invoked on
+    /// the thread which emits the notice, which is the executor thread
+    /// when notices are delivered asynchronously.
+    ///
+    /// The callback remains subscribed as long as the returned handle is
+    /// alive.
+    ///
+    /// \sa SetTfNoticeDelivery
+    template <class T>
+    Subscription Subscribe(std::function<void(const T&)> callback);
+
+    /// \brief
+    /// Indicate whether notices emitted are sent as PXR_NS::TfNotice.
+    /// \sa SetTfNoticeDelivery
+    UNF_API bool IsTfNoticeDelivery() const { return _tfNoticeDelivery; }
+
+    /// \brief
+    /// Set whether notices emitted are sent as PXR_NS::TfNotice.
+    ///
+    /// By default, notices are sent to PXR_NS::TfNotice listeners in
+    /// addition to callbacks subscribed to the broker. Disabling it limits
+    /// delivery to subscribed callbacks, which removes the cost of looking
+    /// up PXR_NS::TfNotice listeners for each notice.
+    ///
+    /// \warning
+    /// Dispatchers and Python listeners registered via PXR_NS::TfNotice
+    /// will not receive any notices when disabled.
+    UNF_API void SetTfNoticeDelivery(bool enabled);
+
+    /// \brief
+    /// Indicate whether dispatchers only listen to incoming notices while
+    /// notices they emit are in demand.
+    ///
+    /// \sa SetDemandDriven
+    UNF_API bool IsDemandDriven() const { return _demandDriven; }
+
+    /// \brief
+    /// Set whether dispatchers only listen to incoming notices while notices
+    /// they emit are in demand.
+    ///
+    /// By default, dispatchers listen to incoming notices as soon as the
+    /// broker is created, so that a notice is created for each
+    /// PXR_NS::UsdNotice::StageNotice received even if no clients are
+    /// listening. When enabled, listeners are only registered for notice
+    /// types in demand and revoked when demand goes away, so that stages
+    /// without clients do not pay any conversion cost.
+    ///
+    /// Notice types are in demand while callbacks are subscribed to them,
+    /// or while a handle returned by Demand is alive.
+    ///
+    /// \warning
+    /// Listeners registered via PXR_NS::TfNotice cannot be detected by the
+    /// broker, and will not receive notices unless demand is declared with
+    /// Demand.
+    ///
+    /// \sa Subscribe
+    /// \sa Demand
+    UNF_API void SetDemandDriven(bool enabled);
+
+    /// \brief
+    /// Declare demand for notices of type \p T.
+    ///
+    /// The demand is withdrawn when the returned handle is reset or
+    /// destroyed.
+    ///
+    /// \sa SetDemandDriven
+    template <class T>
+    Subscription Demand()
+    {
+        return _Demand(T::GetStaticTypeIndex());
+    }
+
+    /// \brief
+    /// Indicate whether notices of type \p T are in demand.
+    ///
+    /// \sa SetDemandDriven
+    template <class T>
+    bool IsInDemand() const
+    {
+        return _IsInDemand(T::GetStaticTypeIndex());
+    }
+
     /// \brief
     /// Create and send a UnfNotice::StageNotice notice via the broker.
     ///
@@ -163,8 +558,54 @@ class Broker : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
   private:
     Broker(const PXR_NS::UsdStageWeakPtr&);
 
-    /// Un-register brokers targeting expired stages.
-    static void _CleanCache();
+    /// Return priority of notice type associated with \p index.
+    UNF_API int _GetPriority(size_t index) const;
+
+    /// Set priority of notice type associated with \p index.
+    UNF_API void _SetPriority(size_t index, int priority);
+
+    /// Subscribe \p callback to notices of type associated with \p index.
+    UNF_API Subscription _Subscribe(
+        size_t index,
+        std::function<void(const UnfNotice::StageNotice&)> callback);
+
+    /// Callbacks subscribed organized per notice type index.
+    struct _SubscriberTable;
+
+    /// Declare demand for notices of type associated with \p index.
+    UNF_API Subscription _Demand(size_t index);
+
+    /// \brief
+    /// Increment demand for notices of type associated with \p index.
+    ///
+    /// Dispatchers are updated if the notice type was not in demand.
+    UNF_API void _AddDemand(size_t index);
+
+    /// \brief
+    /// Decrement demand for notices of type associated with \p index.
+    ///
+    /// Dispatchers are updated if the notice type is no longer in demand.
+    UNF_API void _RemoveDemand(size_t index);
+
+    /// Indicate whether notices of type associated with \p index are in
+    /// demand.
+    UNF_API bool _IsInDemand(size_t index) const;
+
+    /// Register or revoke listeners of all dispatchers depending on demand.
+    void _UpdateDispatchers();
+
+    /// Dispatchers update demand for notices they consume.
+    friend class Dispatcher;
+
+    /// \brief
+    /// Destinations of notices emitted.
+    ///
+    /// \note
+    /// Copied into tasks so that notices can be delivered asynchronously.
+    struct _Recipients;
+
+    /// Return destinations of notices emitted.
+    _Recipients _GetRecipients() const;
 
     /// Discover all dispatchers registered as plugins.
     void _DiscoverDispatchers();
@@ -181,42 +622,316 @@ class Broker : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
     template <class OutputPtr, class OutputFactory>
     void _LoadFromPlugins(const PXR_NS::TfType& type);
 
-    struct UsdStageWeakPtrHasher {
-        std::size_t operator()(const PXR_NS::UsdStageWeakPtr& ptr) const
-        {
-            return hash_value(ptr);
-        }
-    };
-
-    /// Record each hashed stage pointer to its corresponding broker pointer.
-    static std::unordered_map<
-        PXR_NS::UsdStageWeakPtr, BrokerPtr, UsdStageWeakPtrHasher>
-        Registry;
-
     class _NoticeMerger {
       public:
-        _NoticeMerger(CapturePredicate predicate = CapturePredicate::Default());
+        _NoticeMerger(
+            CapturePredicate predicate = CapturePredicate::Default(),
+            bool streaming = false,
+            size_t parallelThreshold = 0,
+            size_t budget = 0,
+            PXR_NS::SdfPathVector scope = PXR_NS::SdfPathVector(),
+            bool batchedAncestor = false,
+            bool joined = false);
+
+        /// \brief
+        /// Indicate whether a nested transaction started with \p predicate
+        /// can be collapsed into this merger.
+        ///
+        /// Nested transactions can be collapsed when they capture the same
+        /// notices in the same way, or when they are started without
+        /// predicate nor scope, as joining them would be equivalent to
+        /// capturing notices in this merger directly.
+        bool CanNest(
+            const CapturePredicate& predicate,
+            bool streaming,
+            const PXR_NS::SdfPathVector& scope) const;
 
+        /// Record nested transaction collapsed into this merger.
+        void Nest() { _depth++; }
+
+        /// \brief
+        /// Close nested transaction collapsed into this merger.
+        ///
+        /// Return false if no nested transaction was collapsed.
+        bool Unnest();
+
+        /// \brief
+        /// Indicate whether \p notice can be captured by this merger.
+        ///
+        /// Always return true for batched predicates, which are only
+        /// evaluated when the transaction ends.
+        bool Accept(const UnfNotice::StageNotice& notice) const;
+
+        /// \brief
+        /// Indicate whether notices are held separately until a batched
+        /// predicate is evaluated by this merger or an enclosing one.
+        bool IsMergeDeferred() const { return _batched || _batchedAncestor; }
+
+        /// Return subtrees to which captured notices are restricted, or an
+        /// empty list if notices are not restricted.
+        const PXR_NS::SdfPathVector& GetScope() const { return _scope; }
+
+        /// \brief
+        /// Capture notice if accepted, after trimming it to the scope.
+        ///
+        /// The predicate is evaluated immediately, even if batched.
         void Add(const UnfNotice::StageNoticeRefPtr&);
+
+        /// Capture materialized notice without evaluating predicate nor
+        /// scope.
+        void Hold(const UnfNotice::StageNoticeRefPtr&);
         void Join(_NoticeMerger&);
+
+        /// \brief
+        /// Remove notices held which are rejected by a batched predicate.
+        ///
+        /// All notices held are evaluated within a single batch. Nothing is
+        /// done if the predicate is evaluated when notices are captured.
+        ///
+        /// \sa CapturePredicate::IsBatched
+        void Filter();
+
+        /// Return number of notices held.
+        size_t GetCount() const;
+
+        /// Indicate whether no notices are held.
+        bool IsEmpty() const { return _order.empty(); }
+
+        /// \brief
+        /// Update settings of merger recycled for a new transaction.
+        ///
+        /// \warning
+        /// Merger must be cleared.
+        void Configure(
+            CapturePredicate predicate,
+            bool streaming,
+            size_t parallelThreshold,
+            size_t budget,
+            PXR_NS::SdfPathVector scope,
+            bool batchedAncestor = false,
+            bool joined = false);
+
+        /// \brief
+        /// Release all notices held.
+        ///
+        /// The capacity of notice lists is kept so that the merger can be
+        /// recycled without allocating memory.
+        void Clear();
+
+        /// \brief
+        /// Sort notice types by decreasing \p priorities, addressed by
+        /// notice type index.
+        ///
+        /// Notice types with identical priorities are kept in the order in
+        /// which they were first captured.
+        void Prioritize(const std::vector<int>& priorities);
+
         void Merge();
         void PostProcess();
-        void Send(const PXR_NS::UsdStageWeakPtr&);
+        void Send(const _Recipients&);
 
       private:
         using _NoticePtrList = std::vector<UnfNotice::StageNoticeRefPtr>;
-        using _NoticePtrMap = std::unordered_map<std::string, _NoticePtrList>;
 
-        _NoticePtrMap _noticeMap;
+        /// Notice lists addressed by notice type index.
+        using _NoticePtrTable = std::vector<_NoticePtrList>;
+
+        /// Append \p notice to \p notices, or fold it into the notice of
+        /// the list notices are folded into when merging is streamed.
+        ///
+        /// \sa _joined
+        void _Append(
+            _NoticePtrList& notices, const UnfNotice::StageNoticeRefPtr& notice);
+
+        /// Fold all \p notices following index \p first into the notice at
+        /// this index if notices are mergeable.
+        void _Merge(_NoticePtrList& notices, size_t first = 0);
+
+        /// Merge all \p notices following index \p first into the notice at
+        /// this index by pairs within a concurrent tree reduction.
+        static void _Reduce(_NoticePtrList& notices, size_t first = 0);
+
+        /// Indicate whether notice types should be processed concurrently.
+        bool _ShouldRunParallel() const;
+
+        /// Consolidate mergeable notices if \p count notices captured
+        /// exhaust the budget.
+        void _Spend(size_t count);
+
+        _NoticePtrTable _noticeTable;
+
+        /// Notice type indices in the order in which notices are sent.
+        std::vector<size_t> _order;
+
         CapturePredicate _predicate;
+
+        /// Subtrees to which captured notices are restricted, or empty if
+        /// notices are not restricted.
+        PXR_NS::SdfPathVector _scope;
+
+        /// Indicate whether notices are merged as soon as they are added.
+        bool _streaming;
+
+        /// Indicate whether the predicate is evaluated when the transaction
+        /// ends, in which case notices are not merged before.
+        bool _batched;
+
+        /// Indicate whether an enclosing transaction evaluates a batched
+        /// predicate when it ends, in which case notices are not merged
+        /// before either.
+        bool _batchedAncestor;
+
+        /// Indicate whether notices held are joined into another merger
+        /// when the transaction ends, in which case the first notice of
+        /// each type is kept as captured and following notices are folded
+        /// into the second one, prepared as within a reduction. Merging the
+        /// joined notices is then identical to a sequential merge.
+        bool _joined;
+
+        /// Minimum number of notices from which notice types are processed
+        /// concurrently, or 0 if disabled.
+        size_t _parallelThreshold;
+
+        /// Indicate whether notice types are processed concurrently.
+        bool _parallel = false;
+
+        /// Number of notices captured after which mergeable notices are
+        /// consolidated, or 0 if unlimited.
+        size_t _budget;
+
+        /// Number of notices captured since last consolidation.
+        size_t _spent = 0;
+
+        /// Maximum capacity of notice lists kept when merger is cleared.
+        static constexpr size_t _maxClearedCapacity = 1024;
+
+        /// Number of nested transactions collapsed into this merger.
+        size_t _depth = 0;
     };
 
+    /// Return transaction stack used by the calling thread.
+    std::vector<_NoticeMerger>& _GetMergers();
+
+    /// Return mergers recycled by the calling thread.
+    std::vector<_NoticeMerger>& _GetMergerPool();
+
+    /// \brief
+    /// Capture \p notice within the innermost transaction of \p mergers.
+    ///
+    /// The notice must be accepted by all transactions started, and is
+    /// trimmed to the scope of each transaction.
+    void _Capture(
+        std::vector<_NoticeMerger>& mergers,
+        const UnfNotice::StageNoticeRefPtr& notice);
+
+    /// Push new transaction with \p predicate and \p scope onto the
+    /// transaction stack, recycling a merger if possible.
+    void _PushMerger(
+        const CapturePredicate& predicate, PXR_NS::SdfPathVector scope);
+
+    /// Pop transaction from the transaction stack and recycle its merger.
+    void _PopMerger();
+
+    /// Close the outermost transaction of the calling thread when
+    /// transactions are local to each thread.
+    void _EndThreadLocalTransaction(_NoticeMerger&);
+
+    /// Add notices from \p merger to the implicit batch, and emit batch if
+    /// necessary.
+    void _AddToAutoBatch(_NoticeMerger& merger);
+
+    /// Add \p notice to the implicit batch, and emit batch if necessary.
+    void _AddToAutoBatch(const UnfNotice::StageNoticeRefPtr& notice);
+
+    /// Return implicit batch, and create it if necessary.
+    _NoticeMerger& _GetAutoBatch();
+
+    /// Emit notices from the implicit batch if thresholds are reached.
+    void _UpdateAutoBatch();
+
+    /// Emit notices from the implicit batch.
+    void _FlushAutoBatch();
+
+    /// Emit \p notice, or hand it over to the executor if necessary.
+    void _SendNow(const UnfNotice::StageNoticeRefPtr& notice);
+
+    /// Consolidate and emit notices captured by \p merger, or hand them over
+    /// to the executor if necessary.
+    void _Deliver(_NoticeMerger&& merger);
+
     /// Usd Stage associated with broker.
     PXR_NS::UsdStageWeakPtr _stage;
 
     /// List of NoticeMerger objects which handle transactions.
     std::vector<_NoticeMerger> _mergers;
 
+    /// NoticeMerger objects recycled from transactions closed.
+    std::vector<_NoticeMerger> _mergerPool;
+
+    /// Maximum number of NoticeMerger objects recycled.
+    static constexpr size_t _maxMergerPoolSize = 8;
+
+    /// Indicate whether each thread keeps its own stack of transactions.
+    bool _threadLocal = false;
+
+    /// \brief
+    /// Transaction stacks and capture buffers recorded per thread.
+    ///
+    /// \note
+    /// Only created when transactions are local to each thread.
+    struct _ThreadLocalData;
+    std::unique_ptr<_ThreadLocalData> _threadLocalData;
+
+    /// Executor delivering notices asynchronously, if any.
+    ExecutorPtr _executor;
+
+    /// Indicate whether notices are batched outside of transactions.
+    bool _autoBatching = false;
+
+    /// Maximum number of notices batched, or 0 if unlimited.
+    size_t _autoBatchThreshold = 0;
+
+    /// Interval in seconds after which notices batched are emitted, or 0 if
+    /// unlimited.
+    double _autoBatchInterval = 0.0;
+
+    /// Notices batched outside of transactions, if any.
+    std::unique_ptr<_NoticeMerger> _autoBatch;
+
+    /// Time at which first notice was batched.
+    std::chrono::steady_clock::time_point _autoBatchStart;
+
+    /// Indicate whether notices are merged as soon as they are captured.
+    bool _streamingMerge = false;
+
+    /// Minimum number of notices from which notice types are processed
+    /// concurrently, or 0 if disabled.
+    size_t _parallelThreshold = 0;
+
+    /// Number of notices captured within a transaction after which mergeable
+    /// notices are consolidated, or 0 if unlimited.
+    size_t _transactionBudget = 0;
+
+    /// Priorities of notice types, addressed by notice type index.
+    std::vector<int> _priorities;
+
+    /// Indicate whether notices emitted are sent as PXR_NS::TfNotice.
+    bool _tfNoticeDelivery = true;
+
+    /// Callbacks subscribed to notices emitted.
+    std::shared_ptr<_SubscriberTable> _subscribers;
+
+    /// Indicate whether dispatchers only listen to incoming notices while
+    /// notices they emit are in demand.
+    bool _demandDriven = false;
+
+    /// Number of demands addressed by notice type index.
+    std::vector<size_t> _demand;
+
+    /// Guard demand. The mutex is recursive as updating dispatchers can
+    /// update demand for notices they consume.
+    mutable std::recursive_mutex _demandMutex;
+
     /// List of registered Dispatchers.
     std::unordered_map<std::string, DispatcherPtr> _dispatcherMap;
 };
@@ -230,6 +945,29 @@ void Broker::Send(Args&&... args)
     Send(_notice);
 }
 
+template <class UnfNotice>
+int Broker::GetPriority() const
+{
+    return _GetPriority(UnfNotice::GetStaticTypeIndex());
+}
+
+template <class UnfNotice>
+void Broker::SetPriority(int priority)
+{
+    _SetPriority(UnfNotice::GetStaticTypeIndex(), priority);
+}
+
+template <class T>
+Subscription Broker::Subscribe(std::function<void(const T&)> callback)
+{
+    return _Subscribe(
+        T::GetStaticTypeIndex(),
+        [callback = std::move(callback)](
+            const UnfNotice::StageNotice& notice) {
+            callback(static_cast<const T&>(notice));
+        });
+}
+
 template <class T>
 DispatcherPtr Broker::_AddDispatcher()
 {
@@ -1,34 +1,417 @@
 #include "unf/capturePredicate.h"
+#include "unf/notice.h"
+
+#include <pxr/base/tf/diagnostic.h>
+#include <pxr/base/tf/type.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <typeinfo>
+#include <utility>
 #include <vector>
 
+PXR_NAMESPACE_USING_DIRECTIVE
+
 namespace unf {
 
+namespace {
+
+// Predicate returning the same result for each notice.
+template <bool Result>
+class _ConstantEvaluator : public CapturePredicate::Evaluator {
+  public:
+    bool operator()(const UnfNotice::StageNotice&) const override
+    {
+        return Result;
+    }
+};
+
+// Predicate delegating to a function.
+class _FunctionEvaluator : public CapturePredicate::Evaluator {
+  public:
+    explicit _FunctionEvaluator(const CapturePredicateFunc& function)
+        : _function(function)
+    {
+    }
+
+    bool operator()(const UnfNotice::StageNotice& notice) const override
+    {
+        return _function(notice);
+    }
+
+  private:
+    CapturePredicateFunc _function;
+};
+
+// Predicate delegating to a function only invoked once per notice type.
+class _PerTypeEvaluator : public CapturePredicate::Evaluator {
+  public:
+    explicit _PerTypeEvaluator(const CapturePredicateFunc& function)
+        : _function(function)
+    {
+    }
+
+    bool operator()(const UnfNotice::StageNotice& notice) const override
+    {
+        size_t index = notice.GetTypeIndex();
+
+        {
+            std::shared_lock<std::shared_mutex> lock(_mutex);
+            if (index < _results.size() && _results[index] != _Unknown) {
+                return _results[index] == _Allowed;
+            }
+        }
+
+        // Function is invoked without holding the lock as it could acquire
+        // other locks, such as the Python GIL.
+        bool result = _function(notice);
+
+        std::unique_lock<std::shared_mutex> lock(_mutex);
+        if (index >= _results.size()) {
+            _results.resize(index + 1, _Unknown);
+        }
+        _results[index] = result ? _Allowed : _Blocked;
+
+        return result;
+    }
+
+  private:
+    enum _Result : uint8_t { _Unknown, _Allowed, _Blocked };
+
+    CapturePredicateFunc _function;
+
+    // Results memoized per notice type index.
+    mutable std::vector<uint8_t> _results;
+    mutable std::shared_mutex _mutex;
+};
+
+// Predicate testing notice type index against a bitmask.
+class _TypeEvaluator : public CapturePredicate::Evaluator {
+  public:
+    _TypeEvaluator(const std::vector<size_t>& indices, bool allow)
+        : _allow(allow)
+    {
+        for (size_t index : indices) {
+            size_t word = index / 64;
+            if (word >= _mask.size()) {
+                _mask.resize(word + 1, 0);
+            }
+            _mask[word] |= uint64_t(1) << (index % 64);
+        }
+    }
+
+    bool operator()(const UnfNotice::StageNotice& notice) const override
+    {
+        size_t index = notice.GetTypeIndex();
+        size_t word = index / 64;
+
+        bool found = word < _mask.size() &&
+                     (_mask[word] & (uint64_t(1) << (index % 64))) != 0;
+        return found == _allow;
+    }
+
+  private:
+    // Bits set for each type index recorded.
+    std::vector<uint64_t> _mask;
+
+    // Indicate whether types recorded are allowed or blocked.
+    bool _allow;
+};
+
+// Predicate testing paths of ObjectsChanged notices against prefixes.
+class _PathEvaluator : public CapturePredicate::Evaluator {
+  public:
+    explicit _PathEvaluator(SdfPathVector prefixes)
+        : _prefixes(std::move(prefixes))
+    {
+        // Prefixes nested within other prefixes are redundant.
+        SdfPath::RemoveDescendentPaths(&_prefixes);
+    }
+
+    bool operator()(const UnfNotice::StageNotice& notice) const override
+    {
+        using UnfNotice::ObjectsChanged;
+
+        if (notice.GetTypeIndex() != ObjectsChanged::GetStaticTypeIndex()) {
+            return true;
+        }
+
+        // Notices referencing data from their originating notice are
+        // evaluated without copying it, as they might be rejected.
+        const auto& _notice = static_cast<const ObjectsChanged&>(notice);
+        return _notice.AffectsPaths(_prefixes);
+    }
+
+  private:
+    SdfPathVector _prefixes;
+};
+
+// Predicate combining two predicates with short-circuit evaluation.
+template <bool Conjunction>
+class _BinaryEvaluator : public CapturePredicate::Evaluator {
+  public:
+    _BinaryEvaluator(CapturePredicate first, CapturePredicate second)
+        : _first(std::move(first)), _second(std::move(second))
+    {
+    }
+
+    bool operator()(const UnfNotice::StageNotice& notice) const override
+    {
+        if (Conjunction) {
+            return _first(notice) && _second(notice);
+        }
+        return _first(notice) || _second(notice);
+    }
+
+    void Evaluate(
+        const std::vector<UnfNotice::StageNoticeRefPtr>& notices,
+        std::vector<bool>& results) const override
+    {
+        _first.Evaluate(notices, results);
+
+        // Only evaluate second predicate for notices which are not decided
+        // by the first one, within a single batch.
+        std::vector<size_t> indices;
+        std::vector<UnfNotice::StageNoticeRefPtr> undecided;
+
+        for (size_t index = 0; index < notices.size(); ++index) {
+            if (results[index] != Conjunction) continue;
+
+            indices.push_back(index);
+            undecided.push_back(notices[index]);
+        }
+
+        if (undecided.empty()) return;
+
+        std::vector<bool> _results;
+        _second.Evaluate(undecided, _results);
+
+        for (size_t index = 0; index < indices.size(); ++index) {
+            results[indices[index]] = _results[index];
+        }
+    }
+
+    bool IsBatched() const override
+    {
+        return _first.IsBatched() || _second.IsBatched();
+    }
+
+  private:
+    CapturePredicate _first;
+    CapturePredicate _second;
+};
+
+// Predicate negating another predicate.
+class _NotEvaluator : public CapturePredicate::Evaluator {
+  public:
+    explicit _NotEvaluator(CapturePredicate predicate)
+        : _predicate(std::move(predicate))
+    {
+    }
+
+    bool operator()(const UnfNotice::StageNotice& notice) const override
+    {
+        return !_predicate(notice);
+    }
+
+    void Evaluate(
+        const std::vector<UnfNotice::StageNoticeRefPtr>& notices,
+        std::vector<bool>& results) const override
+    {
+        _predicate.Evaluate(notices, results);
+        results.flip();
+    }
+
+    bool IsBatched() const override { return _predicate.IsBatched(); }
+
+  private:
+    CapturePredicate _predicate;
+};
+
+// Resolve type indices from notice types.
+std::vector<size_t> _GetTypeIndices(
+    const std::vector<TfType>& types,
+    size_t (*getTypeIndex)(const std::type_info&))
+{
+    static const TfType root = TfType::Find<UnfNotice::StageNotice>();
+
+    std::vector<size_t> indices;
+    indices.reserve(types.size());
+
+    for (const auto& type : types) {
+        if (!type.IsA(root)) {
+            TF_CODING_ERROR(
+                "Type '%s' is not derived from 'StageNotice'.",
+                type.GetTypeName().c_str());
+            continue;
+        }
+        indices.push_back(getTypeIndex(type.GetTypeid()));
+    }
+
+    return indices;
+}
+
+}  // anonymous namespace
+
 CapturePredicate::CapturePredicate(const CapturePredicateFunc& function)
-    : _function(function)
+{
+    if (function) {
+        _evaluator = std::make_shared<const _FunctionEvaluator>(function);
+    }
+}
+
+CapturePredicate::CapturePredicate(EvaluatorPtr evaluator)
+    : _evaluator(std::move(evaluator))
 {
 }
 
 bool CapturePredicate::operator()(const UnfNotice::StageNotice& notice) const
 {
-    if (!_function) return true;
-    return _function(notice);
+    if (!_evaluator) return true;
+    return (*_evaluator)(notice);
+}
+
+void CapturePredicate::Evaluate(
+    const std::vector<UnfNotice::StageNoticeRefPtr>& notices,
+    std::vector<bool>& results) const
+{
+    if (!_evaluator) {
+        results.assign(notices.size(), true);
+        return;
+    }
+
+    _evaluator->Evaluate(notices, results);
+}
+
+void CapturePredicate::Filter(
+    std::vector<UnfNotice::StageNoticeRefPtr>& notices) const
+{
+    if (!_evaluator || notices.empty()) return;
+
+    std::vector<bool> results;
+    _evaluator->Evaluate(notices, results);
+
+    size_t count = 0;
+    for (size_t index = 0; index < notices.size(); ++index) {
+        if (!results[index]) continue;
+
+        if (count != index) {
+            notices[count] = std::move(notices[index]);
+        }
+        count++;
+    }
+
+    notices.resize(count);
+}
+
+bool CapturePredicate::IsBatched() const
+{
+    return _evaluator && _evaluator->IsBatched();
+}
+
+bool CapturePredicate::operator==(const CapturePredicate& other) const
+{
+    if (_evaluator == other._evaluator) return true;
+    return IsDefault() && other.IsDefault();
+}
+
+bool CapturePredicate::IsDefault() const
+{
+    return !_evaluator || _evaluator == Default()._evaluator;
 }
 
 CapturePredicate CapturePredicate::Default()
 {
-    auto function = [](const UnfNotice::StageNotice&) { return true; };
-    return CapturePredicate(function);
+    // Share evaluator between default predicates, so that they can be
+    // identified.
+    static const CapturePredicate predicate(
+        std::make_shared<const _ConstantEvaluator<true> >());
+    return predicate;
 }
 
 CapturePredicate CapturePredicate::BlockAll()
 {
-    auto function = [](const UnfNotice::StageNotice&) { return false; };
-    return CapturePredicate(function);
+    static const CapturePredicate predicate(
+        std::make_shared<const _ConstantEvaluator<false> >());
+    return predicate;
+}
+
+CapturePredicate CapturePredicate::AllowTypes(const std::vector<TfType>& types)
+{
+    return _FromTypeIndices(
+        _GetTypeIndices(types, &UnfNotice::StageNotice::_GetTypeIndex), true);
+}
+
+CapturePredicate CapturePredicate::BlockTypes(const std::vector<TfType>& types)
+{
+    return _FromTypeIndices(
+        _GetTypeIndices(types, &UnfNotice::StageNotice::_GetTypeIndex),
+        false);
+}
+
+CapturePredicate CapturePredicate::UnderPaths(const SdfPathVector& prefixes)
+{
+    return CapturePredicate(std::make_shared<const _PathEvaluator>(prefixes));
+}
+
+CapturePredicate CapturePredicate::And(
+    const CapturePredicate& first, const CapturePredicate& second)
+{
+    // Capturing every notice does not restrict the other predicate.
+    if (first.IsDefault()) return second;
+    if (second.IsDefault()) return first;
+
+    return CapturePredicate(
+        std::make_shared<const _BinaryEvaluator<true> >(first, second));
+}
+
+CapturePredicate CapturePredicate::Or(
+    const CapturePredicate& first, const CapturePredicate& second)
+{
+    if (first.IsDefault() || second.IsDefault()) return Default();
+
+    return CapturePredicate(
+        std::make_shared<const _BinaryEvaluator<false> >(first, second));
+}
+
+CapturePredicate CapturePredicate::Not(const CapturePredicate& predicate)
+{
+    if (predicate.IsDefault()) return BlockAll();
+
+    return CapturePredicate(std::make_shared<const _NotEvaluator>(predicate));
+}
+
+CapturePredicate CapturePredicate::PerType(
+    const CapturePredicateFunc& function)
+{
+    if (!function) return Default();
+
+    return CapturePredicate(
+        std::make_shared<const _PerTypeEvaluator>(function));
+}
+
+void CapturePredicate::Evaluator::Evaluate(
+    const std::vector<UnfNotice::StageNoticeRefPtr>& notices,
+    std::vector<bool>& results) const
+{
+    results.resize(notices.size());
+    for (size_t index = 0; index < notices.size(); ++index) {
+        results[index] = (*this)(*notices[index]);
+    }
+}
+
+CapturePredicate CapturePredicate::_FromTypeIndices(
+    const std::vector<size_t>& indices, bool allow)
+{
+    return CapturePredicate(
+        std::make_shared<const _TypeEvaluator>(indices, allow));
 }
 
 }  // namespace unf
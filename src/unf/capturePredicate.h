@@ -6,7 +6,12 @@
 #include "unf/api.h"
 #include "unf/notice.h"
 
+#include <pxr/base/tf/type.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -21,7 +26,17 @@ using CapturePredicateFunc = std::function<bool(const UnfNotice::StageNotice&)>;
 /// Predicate functor which indicates whether a notice can be captured during
 /// a transaction.
 ///
-/// Common predicates are provided as static methods for convenience.
+/// Common predicates are provided as static methods for convenience. Apart
+/// from predicates created from a function, they are evaluated natively
+/// without invoking any function object, and can be combined with And, Or
+/// and Not.
+///
+/// \code{.cpp}
+/// // Capture changes under '/World', and any notice other than 'Foo'.
+/// auto predicate = CapturePredicate::And(
+///     CapturePredicate::BlockTypes<Foo>(),
+///     CapturePredicate::UnderPaths({SdfPath("/World")}));
+/// \endcode
 ///
 /// \note
 /// We used a functor embedding a CapturePredicateFunc instead of defining
@@ -44,14 +59,181 @@ class CapturePredicate {
     /// Invoke boolean predicate on UnfNotice::StageNotice \p notice.
     UNF_API bool operator()(const UnfNotice::StageNotice&) const;
 
+    /// \brief
+    /// Indicate whether each of \p notices can be captured, by setting
+    /// \p results in the same order.
+    ///
+    /// Notices are evaluated within a single batch.
+    ///
+    /// \sa Evaluator::Evaluate
+    UNF_API void Evaluate(
+        const std::vector<UnfNotice::StageNoticeRefPtr>& notices,
+        std::vector<bool>& results) const;
+
+    /// \brief
+    /// Remove \p notices which cannot be captured.
+    ///
+    /// Notices are evaluated within a single batch, and the order of notices
+    /// kept is preserved.
+    ///
+    /// \sa Evaluator::Evaluate
+    UNF_API void Filter(
+        std::vector<UnfNotice::StageNoticeRefPtr>& notices) const;
+
+    /// \brief
+    /// Indicate whether notices should be evaluated within a single batch
+    /// when the transaction ends instead of when each notice is captured.
+    ///
+    /// Predicates combined with And, Or or Not are batched if any of the
+    /// predicates combined is batched.
+    ///
+    /// \sa Evaluator::IsBatched
+    UNF_API bool IsBatched() const;
+
+    /// \brief
+    /// Indicate whether predicates are identical.
+    ///
+    /// Copies of a predicate are identical, and all predicates which capture
+    /// every notice type without a custom function are identical.
+    ///
+    /// \note
+    /// Distinct functions are never considered identical, even if they
+    /// return the same result for each notice.
+    UNF_API bool operator==(const CapturePredicate&) const;
+
+    /// Indicate whether predicates are not identical.
+    UNF_API bool operator!=(const CapturePredicate& other) const
+    {
+        return !(*this == other);
+    }
+
+    /// \brief
+    /// Indicate whether predicate captures every notice type.
+    ///
+    /// \sa Default
+    UNF_API bool IsDefault() const;
+
     /// Create a predicate which return true for each notice type.
     UNF_API static CapturePredicate Default();
 
     /// Create a predicate which return false for each notice type.
     UNF_API static CapturePredicate BlockAll();
 
+    /// Create a predicate which only return true for notices of \p types.
+    template <class... Types>
+    static CapturePredicate AllowTypes()
+    {
+        return _FromTypeIndices({Types::GetStaticTypeIndex()...}, true);
+    }
+
+    /// Create a predicate which return false for notices of \p types.
+    template <class... Types>
+    static CapturePredicate BlockTypes()
+    {
+        return _FromTypeIndices({Types::GetStaticTypeIndex()...}, false);
+    }
+
+    /// \brief
+    /// Create a predicate which only return true for notices of \p types.
+    ///
+    /// Types must be derived from UnfNotice::StageNotice.
+    UNF_API static CapturePredicate AllowTypes(
+        const std::vector<PXR_NS::TfType>& types);
+
+    /// \brief
+    /// Create a predicate which return false for notices of \p types.
+    ///
+    /// Types must be derived from UnfNotice::StageNotice.
+    UNF_API static CapturePredicate BlockTypes(
+        const std::vector<PXR_NS::TfType>& types);
+
+    /// \brief
+    /// Create a predicate which only return true for UnfNotice::ObjectsChanged
+    /// notices affecting paths under \p prefixes.
+    ///
+    /// A notice affects a prefix when a path resynced is a prefix or a
+    /// descendant of it, or when a path modified without being resynced is a
+    /// descendant of it. Other notice types are not filtered.
+    UNF_API static CapturePredicate UnderPaths(
+        const PXR_NS::SdfPathVector& prefixes);
+
+    /// \brief
+    /// Create a predicate which return true if both predicates return true.
+    ///
+    /// \p second is not evaluated if \p first returns false.
+    UNF_API static CapturePredicate And(
+        const CapturePredicate& first, const CapturePredicate& second);
+
+    /// \brief
+    /// Create a predicate which return true if either predicate returns
+    /// true.
+    ///
+    /// \p second is not evaluated if \p first returns true.
+    UNF_API static CapturePredicate Or(
+        const CapturePredicate& first, const CapturePredicate& second);
+
+    /// Create a predicate which return the opposite of \p predicate.
+    UNF_API static CapturePredicate Not(const CapturePredicate& predicate);
+
+    /// \brief
+    /// Create predicate from a \p function which only depends on the notice
+    /// type.
+    ///
+    /// The function is invoked once for the first notice of each type, and
+    /// its result is memoized for subsequent notices of the same type.
+    ///
+    /// \warning
+    /// The function must not depend on the content of notices.
+    UNF_API static CapturePredicate PerType(
+        const CapturePredicateFunc& function);
+
+    /// \brief
+    /// Interface to evaluate natively whether a notice can be captured.
+    ///
+    /// Evaluators are shared between copies of a predicate, and must not
+    /// be modified once the predicate is created.
+    class Evaluator {
+      public:
+        virtual ~Evaluator() = default;
+
+        /// Indicate whether \p notice can be captured.
+        virtual bool operator()(const UnfNotice::StageNotice&) const = 0;
+
+        /// \brief
+        /// Indicate whether each of \p notices can be captured, by setting
+        /// \p results in the same order.
+        ///
+        /// By default, each notice is evaluated separately.
+        UNF_API virtual void Evaluate(
+            const std::vector<UnfNotice::StageNoticeRefPtr>& notices,
+            std::vector<bool>& results) const;
+
+        /// \brief
+        /// Indicate whether notices should be evaluated within a single
+        /// batch when the transaction ends.
+        ///
+        /// Batched evaluation is useful when each evaluation requires an
+        /// expensive setup which can be shared between notices. Notices
+        /// captured by a transaction started with a batched predicate are
+        /// held without being merged until the transaction ends.
+        ///
+        /// By default, notices are evaluated when they are captured.
+        virtual bool IsBatched() const { return false; }
+    };
+
+    /// Convenient alias for Evaluator shared pointer.
+    using EvaluatorPtr = std::shared_ptr<const Evaluator>;
+
+    /// Create predicate from an \p evaluator.
+    UNF_API explicit CapturePredicate(EvaluatorPtr evaluator);
+
   private:
-    CapturePredicateFunc _function = nullptr;
+    /// Create predicate from type \p indices.
+    UNF_API static CapturePredicate _FromTypeIndices(
+        const std::vector<size_t>& indices, bool allow);
+
+    /// Evaluator shared between copies, so that copies remain identical.
+    EvaluatorPtr _evaluator;
 };
 
 }  // namespace unf
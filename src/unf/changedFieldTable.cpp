@@ -0,0 +1,360 @@
+#include "unf/changedFieldTable.h"
+
+#include <pxr/base/tf/token.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/schema.h>
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <numeric>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace unf {
+
+namespace {
+
+using FieldMask = ChangedFieldTable::FieldMask;
+
+// Number of fields which can be interned within a bitmask.
+constexpr size_t _maskWidth = sizeof(FieldMask) * 8;
+
+// Process-wide table of interned fields.
+class _FieldRegistry {
+  public:
+    static _FieldRegistry& GetInstance()
+    {
+        static _FieldRegistry registry;
+        return registry;
+    }
+
+    // Return index of field, and register it if necessary.
+    size_t GetIndex(const TfToken& field)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(_mutex);
+            auto it = _indices.find(field);
+            if (it != _indices.end()) return it->second;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(_mutex);
+        auto result = _indices.emplace(field, _fields.size());
+        if (result.second) {
+            _fields.push_back(field);
+        }
+        return result.first->second;
+    }
+
+    // Insert all fields referenced by mask into set.
+    void Insert(FieldMask mask, TfTokenSet& fields) const
+    {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+
+        for (size_t index = 0; mask != 0; ++index, mask >>= 1) {
+            if (mask & 1) {
+                fields.insert(_fields[index]);
+            }
+        }
+    }
+
+  private:
+    _FieldRegistry()
+    {
+        // Intern common Sdf fields first to ensure that they fit in
+        // bitmasks.
+        for (const TfToken& field :
+             {SdfFieldKeys->Default,
+              SdfFieldKeys->TimeSamples,
+              SdfFieldKeys->TypeName,
+              SdfFieldKeys->Specifier,
+              SdfFieldKeys->Active,
+              SdfFieldKeys->Kind,
+              SdfFieldKeys->Comment,
+              SdfFieldKeys->Documentation,
+              SdfFieldKeys->Hidden,
+              SdfFieldKeys->Instanceable,
+              SdfFieldKeys->Custom,
+              SdfFieldKeys->Variability,
+              SdfFieldKeys->ConnectionPaths,
+              SdfFieldKeys->TargetPaths,
+              SdfFieldKeys->References,
+              SdfFieldKeys->Payload,
+              SdfFieldKeys->InheritPaths,
+              SdfFieldKeys->Specializes,
+              SdfFieldKeys->VariantSelection,
+              SdfFieldKeys->VariantSetNames,
+              SdfFieldKeys->PrimChildren,
+              SdfFieldKeys->PrimOrder,
+              SdfFieldKeys->Properties,
+              SdfFieldKeys->PropertyOrder,
+              SdfFieldKeys->CustomData,
+              SdfFieldKeys->AssetInfo}) {
+            GetIndex(field);
+        }
+    }
+
+    mutable std::shared_mutex _mutex;
+    std::unordered_map<TfToken, size_t, TfToken::HashFunctor> _indices;
+    std::vector<TfToken> _fields;
+};
+
+// Compare spilled records per path only.
+struct _SpilledPathLess {
+    bool operator()(
+        const std::pair<SdfPath, TfToken>& record, const SdfPath& path) const
+    {
+        return record.first < path;
+    }
+
+    bool operator()(
+        const SdfPath& path, const std::pair<SdfPath, TfToken>& record) const
+    {
+        return path < record.first;
+    }
+};
+
+}  // anonymous namespace
+
+void ChangedFieldTable::Add(const SdfPath& path, const TfTokenVector& fields)
+{
+    _Add(path, fields.begin(), fields.end());
+}
+
+void ChangedFieldTable::Add(const SdfPath& path, const TfTokenSet& fields)
+{
+    _Add(path, fields.begin(), fields.end());
+}
+
+void ChangedFieldTable::Merge(ChangedFieldTable&& table)
+{
+    if (table._paths.empty()) return;
+
+    if (_paths.empty()) {
+        *this = std::move(table);
+        return;
+    }
+
+    // Records remain consolidated if incoming paths are all sorted after
+    // recorded paths.
+    bool consolidated = _consolidated && table._consolidated &&
+                        _paths.back() < table._paths.front();
+
+    _paths.reserve(_paths.size() + table._paths.size());
+    std::move(
+        table._paths.begin(), table._paths.end(), std::back_inserter(_paths));
+
+    _masks.insert(_masks.end(), table._masks.begin(), table._masks.end());
+
+    _spilled.reserve(_spilled.size() + table._spilled.size());
+    std::move(
+        table._spilled.begin(),
+        table._spilled.end(),
+        std::back_inserter(_spilled));
+
+    _consolidated = consolidated;
+
+    table._paths.clear();
+    table._masks.clear();
+    table._spilled.clear();
+
+    // Coalesce records once their number doubles, so that memory remains
+    // bounded when identical paths are merged repeatedly, while keeping the
+    // amortized cost of each merge logarithmic.
+    size_t limit = std::max(2 * _consolidatedSize, _minConsolidateSize);
+    if (GetSize() > limit) {
+        Consolidate();
+    }
+}
+
+void ChangedFieldTable::Consolidate()
+{
+    if (_consolidated) {
+        _consolidatedSize = GetSize();
+        return;
+    }
+
+    // Sort record indices per path.
+    std::vector<size_t> order(_paths.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return _paths[a] < _paths[b];
+    });
+
+    SdfPathVector paths;
+    paths.reserve(_paths.size());
+
+    std::vector<FieldMask> masks;
+    masks.reserve(_masks.size());
+
+    // Coalesce records of identical paths.
+    for (size_t index : order) {
+        if (!paths.empty() && paths.back() == _paths[index]) {
+            masks.back() |= _masks[index];
+        }
+        else {
+            paths.push_back(std::move(_paths[index]));
+            masks.push_back(_masks[index]);
+        }
+    }
+
+    _paths = std::move(paths);
+    _masks = std::move(masks);
+
+    std::sort(_spilled.begin(), _spilled.end());
+    _spilled.erase(
+        std::unique(_spilled.begin(), _spilled.end()), _spilled.end());
+
+    _consolidated = true;
+    _consolidatedSize = GetSize();
+}
+
+void ChangedFieldTable::Restrict(const SdfPathVector& prefixes)
+{
+    auto isInScope = [&](const SdfPath& path) {
+        return std::any_of(
+            prefixes.begin(), prefixes.end(), [&](const SdfPath& prefix) {
+                return path.HasPrefix(prefix);
+            });
+    };
+
+    // Records are filtered in place so that their order is preserved.
+    size_t count = 0;
+    for (size_t index = 0; index < _paths.size(); ++index) {
+        if (!isInScope(_paths[index])) continue;
+
+        if (count != index) {
+            _paths[count] = std::move(_paths[index]);
+            _masks[count] = _masks[index];
+        }
+        count++;
+    }
+
+    _paths.resize(count);
+    _masks.resize(count);
+
+    _spilled.erase(
+        std::remove_if(
+            _spilled.begin(),
+            _spilled.end(),
+            [&](const std::pair<SdfPath, TfToken>& record) {
+                return !isInScope(record.first);
+            }),
+        _spilled.end());
+}
+
+bool ChangedFieldTable::Has(const SdfPath& path) const
+{
+    bool found = false;
+    _FindMask(path, &found);
+    return found;
+}
+
+TfTokenSet ChangedFieldTable::Get(const SdfPath& path) const
+{
+    TfTokenSet fields;
+
+    bool found = false;
+    FieldMask mask = _FindMask(path, &found);
+    if (!found) return fields;
+
+    _FieldRegistry::GetInstance().Insert(mask, fields);
+    _FindSpilled(path, fields);
+    return fields;
+}
+
+ChangedFieldMap ChangedFieldTable::GetMap() const
+{
+    ChangedFieldMap map;
+    map.reserve(_paths.size());
+
+    const auto& registry = _FieldRegistry::GetInstance();
+
+    for (size_t index = 0; index < _paths.size(); ++index) {
+        registry.Insert(_masks[index], map[_paths[index]]);
+    }
+    for (const auto& record : _spilled) {
+        map[record.first].insert(record.second);
+    }
+
+    return map;
+}
+
+template <class Iterator>
+void ChangedFieldTable::_Add(const SdfPath& path, Iterator first, Iterator last)
+{
+    if (first == last) return;
+
+    auto& registry = _FieldRegistry::GetInstance();
+
+    FieldMask mask = 0;
+    for (; first != last; ++first) {
+        size_t index = registry.GetIndex(*first);
+
+        if (index < _maskWidth) {
+            mask |= FieldMask(1) << index;
+        }
+        else {
+            _spilled.emplace_back(path, *first);
+        }
+    }
+
+    if (_consolidated && !_paths.empty() && !(_paths.back() < path)) {
+        _consolidated = false;
+    }
+
+    _paths.push_back(path);
+    _masks.push_back(mask);
+}
+
+ChangedFieldTable::FieldMask ChangedFieldTable::_FindMask(
+    const SdfPath& path, bool* found) const
+{
+    *found = false;
+
+    if (_consolidated) {
+        auto it = std::lower_bound(_paths.begin(), _paths.end(), path);
+        if (it == _paths.end() || *it != path) return 0;
+
+        *found = true;
+        return _masks[std::distance(_paths.begin(), it)];
+    }
+
+    FieldMask mask = 0;
+    for (size_t index = 0; index < _paths.size(); ++index) {
+        if (_paths[index] == path) {
+            mask |= _masks[index];
+            *found = true;
+        }
+    }
+    return mask;
+}
+
+void ChangedFieldTable::_FindSpilled(
+    const SdfPath& path, TfTokenSet& fields) const
+{
+    if (_spilled.empty()) return;
+
+    if (_consolidated) {
+        auto range = std::equal_range(
+            _spilled.begin(), _spilled.end(), path, _SpilledPathLess());
+
+        for (auto it = range.first; it != range.second; ++it) {
+            fields.insert(it->second);
+        }
+        return;
+    }
+
+    for (const auto& record : _spilled) {
+        if (record.first == path) {
+            fields.insert(record.second);
+        }
+    }
+}
+
+}  // namespace unf
@@ -0,0 +1,132 @@
+#ifndef USD_NOTICE_FRAMEWORK_CHANGED_FIELD_TABLE_H
+#define USD_NOTICE_FRAMEWORK_CHANGED_FIELD_TABLE_H
+
+/// \file unf/changedFieldTable.h
+
+#include "unf/api.h"
+
+#include <pxr/base/tf/token.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace unf {
+
+/// Convenient alias for set of tokens.
+using TfTokenSet =
+    std::unordered_set<PXR_NS::TfToken, PXR_NS::TfToken::HashFunctor>;
+
+/// Convenient alias for set of paths.
+using SdfPathSet = std::unordered_set<PXR_NS::SdfPath, PXR_NS::SdfPath::Hash>;
+
+/// Convenient alias for map of token sets organized per path.
+using ChangedFieldMap =
+    std::unordered_map<PXR_NS::SdfPath, TfTokenSet, PXR_NS::SdfPath::Hash>;
+
+/// \class ChangedFieldTable
+///
+/// \brief
+/// Compact record of changed fields organized per path.
+///
+/// Paths are stored in a flat array, each paired with a fixed-width bitmask
+/// of the fields changed. Each bit refers to a field interned within a
+/// process-wide table. Rare fields which cannot be interned within the
+/// bitmask are recorded in a separate list.
+///
+/// Merging tables appends records, which are sorted and coalesced by the
+/// Consolidate method. Queries on a table which is not consolidated remain
+/// correct but require a linear scan, so merging consolidates the table
+/// whenever the number of records doubles since the last consolidation.
+class ChangedFieldTable {
+  public:
+    /// Bitmask of interned fields.
+    using FieldMask = uint64_t;
+
+    UNF_API ChangedFieldTable() = default;
+
+    /// Record changed \p fields for \p path.
+    UNF_API void Add(
+        const PXR_NS::SdfPath& path, const PXR_NS::TfTokenVector& fields);
+
+    /// Record changed \p fields for \p path.
+    UNF_API void Add(const PXR_NS::SdfPath& path, const TfTokenSet& fields);
+
+    /// \brief
+    /// Merge records with another table.
+    ///
+    /// Records are consolidated once their number exceeds twice the number
+    /// of records left by the last consolidation, so that tables merged
+    /// repeatedly with identical paths remain bounded.
+    ///
+    /// \note
+    /// Data will be moved out of incoming table.
+    UNF_API void Merge(ChangedFieldTable&& table);
+
+    /// Sort records per path and coalesce records of identical paths.
+    UNF_API void Consolidate();
+
+    /// Remove records for paths which are not descendants of \p prefixes.
+    UNF_API void Restrict(const PXR_NS::SdfPathVector& prefixes);
+
+    /// Indicate whether records are sorted and unique per path.
+    UNF_API bool IsConsolidated() const { return _consolidated; }
+
+    /// \brief
+    /// Return number of records.
+    ///
+    /// \note
+    /// Records of identical paths are counted separately until the table is
+    /// consolidated.
+    UNF_API size_t GetSize() const { return _paths.size() + _spilled.size(); }
+
+    /// Indicate whether no fields are recorded.
+    UNF_API bool IsEmpty() const { return _paths.empty(); }
+
+    /// Indicate whether changed fields are recorded for \p path.
+    UNF_API bool Has(const PXR_NS::SdfPath& path) const;
+
+    /// Return the set of changed fields recorded for \p path.
+    UNF_API TfTokenSet Get(const PXR_NS::SdfPath& path) const;
+
+    /// Return map of changed fields organized per path.
+    UNF_API ChangedFieldMap GetMap() const;
+
+  private:
+    /// Record changed fields from range for \p path.
+    template <class Iterator>
+    void _Add(const PXR_NS::SdfPath& path, Iterator first, Iterator last);
+
+    /// Return union of bitmasks recorded for \p path.
+    FieldMask _FindMask(const PXR_NS::SdfPath& path, bool* found) const;
+
+    /// Insert fields recorded for \p path in the spill list into \p fields.
+    void _FindSpilled(const PXR_NS::SdfPath& path, TfTokenSet& fields) const;
+
+    /// Recorded paths.
+    PXR_NS::SdfPathVector _paths;
+
+    /// Bitmasks of interned fields recorded for each path.
+    std::vector<FieldMask> _masks;
+
+    /// Fields which could not be interned, recorded per path.
+    std::vector<std::pair<PXR_NS::SdfPath, PXR_NS::TfToken> > _spilled;
+
+    /// Indicate whether records are sorted and unique per path.
+    bool _consolidated = true;
+
+    /// Number of records left by the last consolidation.
+    size_t _consolidatedSize = 0;
+
+    /// Minimum number of records from which merged tables are consolidated.
+    static constexpr size_t _minConsolidateSize = 64;
+};
+
+}  // namespace unf
+
+#endif  // USD_NOTICE_FRAMEWORK_CHANGED_FIELD_TABLE_H
@@ -20,6 +20,48 @@ void Dispatcher::Revoke()
     for (auto& key : _keys) {
         TfNotice::Revoke(key);
     }
+    _keys.clear();
+
+    // Demand for incoming notices is withdrawn with their listener.
+    for (auto& route : _routes) {
+        if (!route.key.IsValid()) continue;
+
+        TfNotice::Revoke(route.key);
+        if (route.input != _noIndex && _broker) {
+            _broker->_RemoveDemand(route.input);
+        }
+    }
+    _routes.clear();
+}
+
+void Dispatcher::Update()
+{
+    // Routes are addressed by index as updating demand for incoming notices
+    // can update this dispatcher recursively.
+    for (size_t index = 0; index < _routes.size(); ++index) {
+        _Update(_routes[index]);
+    }
+}
+
+void Dispatcher::_Update(_Route& route)
+{
+    if (!_broker) return;
+
+    bool active =
+        !_broker->IsDemandDriven() || _broker->_IsInDemand(route.output);
+
+    if (active && !route.key.IsValid()) {
+        route.key = route.listen();
+        if (route.input != _noIndex) {
+            _broker->_AddDemand(route.input);
+        }
+    }
+    else if (!active && route.key.IsValid()) {
+        TfNotice::Revoke(route.key);
+        if (route.input != _noIndex) {
+            _broker->_RemoveDemand(route.input);
+        }
+    }
 }
 
 StageDispatcher::StageDispatcher(const BrokerWeakPtr& broker)
@@ -29,8 +71,6 @@ StageDispatcher::StageDispatcher(const BrokerWeakPtr& broker)
 
 void StageDispatcher::Register()
 {
-    _keys.reserve(4);
-
     _Register<
         UsdNotice::StageContentsChanged,
         UnfNotice::StageContentsChanged>();
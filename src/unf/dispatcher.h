@@ -13,6 +13,11 @@
 #include <pxr/pxr.h>
 #include <pxr/usd/usd/common.h>
 
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
 namespace unf {
 
 /// \class Dispatcher
@@ -40,6 +45,16 @@ class Dispatcher : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
     /// Revoke all registered listeners.
     UNF_API virtual void Revoke();
 
+    /// \brief
+    /// Register or revoke listeners depending on whether notices they emit
+    /// are in demand.
+    ///
+    /// Listeners added with _Register are always registered unless the
+    /// broker is demand-driven.
+    ///
+    /// \sa Broker::SetDemandDriven
+    UNF_API void Update();
+
   protected:
     /// Create a dispatcher targeting a Broker.
     UNF_API Dispatcher(const BrokerWeakPtr&);
@@ -57,6 +72,11 @@ class Dispatcher : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
     ///     UnfNotice::ObjectsChanged>();
     /// \endcode
     ///
+    /// When the broker is demand-driven, the listener is only registered
+    /// while \p OutputNotice notices are in demand. If \p InputNotice is
+    /// itself derived from UnfNotice::StageNotice, it is in demand as long
+    /// as the listener is registered.
+    ///
     /// \warning
     /// The \p OutputNotice notice must be derived from
     /// UnfNotice::StageNotice and must have a constructor which takes an
@@ -66,8 +86,18 @@ class Dispatcher : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
     {
         auto self = PXR_NS::TfCreateWeakPtr(this);
         auto cb = &Dispatcher::_OnReceiving<InputNotice, OutputNotice>;
-        _keys.push_back(
-            PXR_NS::TfNotice::Register(self, cb, _broker->GetStage()));
+        auto stage = _broker->GetStage();
+
+        _Route route;
+        route.output = OutputNotice::GetStaticTypeIndex();
+        route.input = _GetInputIndex<InputNotice>(
+            std::is_base_of<UnfNotice::StageNotice, InputNotice>());
+        route.listen = [self, cb, stage]() {
+            return PXR_NS::TfNotice::Register(self, cb, stage);
+        };
+
+        _routes.push_back(std::move(route));
+        _Update(_routes.back());
     }
 
     /// \brief
@@ -83,6 +113,12 @@ class Dispatcher : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
     {
         PXR_NS::TfRefPtr<OutputNotice> _notice = OutputNotice::Create(notice);
         _broker->Send(_notice);
+
+        // Ensure that notice does not reference the incoming notice if it
+        // is still held after delivery.
+        if (_notice->GetCurrentCount() > 1) {
+            _notice->Materialize();
+        }
     }
 
     /// Broker that the dispatcher is attached to.
@@ -90,6 +126,48 @@ class Dispatcher : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
 
     /// List of handle-objects used for registering listeners.
     std::vector<PXR_NS::TfNotice::Key> _keys;
+
+  private:
+    /// Listener emitting notices from an incoming notice type.
+    struct _Route {
+        /// Type index of notices emitted.
+        size_t output;
+
+        /// Type index of incoming notices if derived from
+        /// UnfNotice::StageNotice, or _noIndex otherwise.
+        size_t input;
+
+        /// Register listener and return its key.
+        std::function<PXR_NS::TfNotice::Key()> listen;
+
+        /// Key of listener registered, invalid while revoked.
+        PXR_NS::TfNotice::Key key;
+    };
+
+    /// Register or revoke listener of \p route depending on demand.
+    UNF_API void _Update(_Route& route);
+
+    /// Return type index of incoming notice derived from
+    /// UnfNotice::StageNotice.
+    template <class InputNotice>
+    static size_t _GetInputIndex(std::true_type)
+    {
+        return InputNotice::GetStaticTypeIndex();
+    }
+
+    /// Return _noIndex for incoming notice which are not derived from
+    /// UnfNotice::StageNotice.
+    template <class InputNotice>
+    static size_t _GetInputIndex(std::false_type)
+    {
+        return _noIndex;
+    }
+
+    /// Index used when incoming notices are not UnfNotice::StageNotice.
+    static constexpr size_t _noIndex = static_cast<size_t>(-1);
+
+    /// Listeners added with _Register.
+    std::vector<_Route> _routes;
 };
 
 /// \class StageDispatcher
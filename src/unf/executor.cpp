@@ -0,0 +1,124 @@
+#include "unf/executor.h"
+
+#include <pxr/base/tf/diagnostic.h>
+#include <pxr/base/tf/refPtr.h>
+#include <pxr/pxr.h>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace unf {
+
+struct ThreadExecutor::_State {
+    /// Tasks waiting to be run.
+    std::deque<ExecutorTask> tasks;
+
+    /// Indicate whether a task is currently running.
+    bool busy = false;
+
+    /// Indicate whether the thread must stop once all tasks have run.
+    bool stop = false;
+
+    std::mutex mutex;
+
+    /// Notify thread that tasks were submitted.
+    std::condition_variable submitted;
+
+    /// Notify waiting threads that all tasks have run.
+    std::condition_variable idle;
+};
+
+TfRefPtr<ThreadExecutor> ThreadExecutor::Create()
+{
+    return TfCreateRefPtr(new ThreadExecutor());
+}
+
+ThreadExecutor::ThreadExecutor()
+    : _state(std::make_shared<_State>()),
+      _thread(&ThreadExecutor::_Run, _state)
+{
+}
+
+ThreadExecutor::~ThreadExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        _state->stop = true;
+    }
+    _state->submitted.notify_one();
+
+    // Thread cannot be joined if executor is released from a task. The
+    // thread keeps the state alive until remaining tasks have run.
+    if (std::this_thread::get_id() == _thread.get_id()) {
+        _thread.detach();
+        return;
+    }
+
+    _thread.join();
+}
+
+void ThreadExecutor::Submit(ExecutorTask task)
+{
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        _state->tasks.push_back(std::move(task));
+    }
+    _state->submitted.notify_one();
+}
+
+void ThreadExecutor::Wait()
+{
+    if (std::this_thread::get_id() == _thread.get_id()) return;
+
+    std::unique_lock<std::mutex> lock(_state->mutex);
+    _state->idle.wait(
+        lock, [&]() { return _state->tasks.empty() && !_state->busy; });
+}
+
+void ThreadExecutor::_Run(std::shared_ptr<_State> state)
+{
+    std::unique_lock<std::mutex> lock(state->mutex);
+
+    while (true) {
+        state->submitted.wait(
+            lock, [&]() { return state->stop || !state->tasks.empty(); });
+
+        // Run remaining tasks before stopping.
+        if (state->tasks.empty()) break;
+
+        ExecutorTask task = std::move(state->tasks.front());
+        state->tasks.pop_front();
+        state->busy = true;
+
+        lock.unlock();
+
+        try {
+            task();
+        }
+        catch (const std::exception& error) {
+            TF_RUNTIME_ERROR("Failed to run task: %s", error.what());
+        }
+        catch (...) {
+            TF_RUNTIME_ERROR("Failed to run task: unknown exception");
+        }
+
+        // Release task before locking, as it could own the last reference
+        // to the executor.
+        task = nullptr;
+
+        lock.lock();
+        state->busy = false;
+
+        if (state->tasks.empty()) {
+            state->idle.notify_all();
+        }
+    }
+}
+
+}  // namespace unf
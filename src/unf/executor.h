@@ -0,0 +1,98 @@
+#ifndef USD_NOTICE_FRAMEWORK_EXECUTOR_H
+#define USD_NOTICE_FRAMEWORK_EXECUTOR_H
+
+/// \file unf/executor.h
+
+#include "unf/api.h"
+
+#include <pxr/base/tf/refBase.h>
+#include <pxr/base/tf/refPtr.h>
+#include <pxr/pxr.h>
+
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace unf {
+
+class Executor;
+
+/// Convenient alias for Executor reference pointer.
+using ExecutorPtr = PXR_NS::TfRefPtr<Executor>;
+
+/// Convenient alias for task submitted to an Executor.
+using ExecutorTask = std::function<void()>;
+
+/// \class Executor
+///
+/// \brief
+/// Interface for objects running tasks submitted by a Broker to deliver
+/// notices asynchronously.
+///
+/// Tasks must be run in the order in which they were submitted, so that
+/// notices are delivered in the order in which they were emitted.
+///
+/// \sa Broker::SetExecutor
+class Executor : public PXR_NS::TfRefBase {
+  public:
+    UNF_API virtual ~Executor() = default;
+
+    /// Schedule \p task to run after all tasks previously submitted.
+    UNF_API virtual void Submit(ExecutorTask task) = 0;
+
+    /// Block until all tasks submitted have run.
+    UNF_API virtual void Wait() = 0;
+};
+
+/// \class ThreadExecutor
+///
+/// \brief
+/// Executor running tasks in order on a dedicated thread.
+///
+/// Remaining tasks are run before the thread is joined on destruction.
+class ThreadExecutor : public Executor {
+  public:
+    /// Create executor and start its thread.
+    UNF_API static PXR_NS::TfRefPtr<ThreadExecutor> Create();
+
+    UNF_API virtual ~ThreadExecutor();
+
+    /// Remove default copy constructor.
+    UNF_API ThreadExecutor(const ThreadExecutor&) = delete;
+
+    /// Remove default assignment operator.
+    UNF_API ThreadExecutor& operator=(const ThreadExecutor&) = delete;
+
+    UNF_API void Submit(ExecutorTask task) override;
+
+    /// \brief
+    /// Block until all tasks submitted have run.
+    ///
+    /// \note
+    /// Return immediately when called from a task, as waiting would
+    /// prevent the thread from running remaining tasks.
+    UNF_API void Wait() override;
+
+  private:
+    ThreadExecutor();
+
+    /// State shared between the executor and its thread.
+    struct _State;
+
+    /// \brief
+    /// Run tasks from \p state until the executor is destroyed.
+    ///
+    /// \note
+    /// The thread owns a reference to the state, so that it remains valid
+    /// when the executor is released from a task and the thread is
+    /// detached.
+    static void _Run(std::shared_ptr<_State> state);
+
+    std::shared_ptr<_State> _state;
+
+    std::thread _thread;
+};
+
+}  // namespace unf
+
+#endif  // USD_NOTICE_FRAMEWORK_EXECUTOR_H
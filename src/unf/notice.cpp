@@ -3,9 +3,15 @@
 #include <pxr/base/tf/notice.h>
 #include <pxr/pxr.h>
 #include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/pathTable.h>
 #include <pxr/usd/usd/notice.h>
 
+#include <algorithm>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
@@ -23,33 +29,252 @@ TF_REGISTRY_FUNCTION(TfType)
     TfType::Define<LayerMutingChanged, TfType::Bases<StageNotice> >();
 }
 
+namespace {
+
+// Indicate whether paths resynced or modified affect any of prefixes.
+template <class ResyncedRange, class InfoRange>
+bool _AffectsPaths(
+    const ResyncedRange& resyncedPaths,
+    const InfoRange& infoPaths,
+    const SdfPathVector& prefixes)
+{
+    // Resyncing an ancestor of a prefix affects the prefix as well.
+    for (const SdfPath& path : resyncedPaths) {
+        for (const auto& prefix : prefixes) {
+            if (path.HasPrefix(prefix) || prefix.HasPrefix(path)) {
+                return true;
+            }
+        }
+    }
+
+    for (const SdfPath& path : infoPaths) {
+        for (const auto& prefix : prefixes) {
+            if (path.HasPrefix(prefix)) return true;
+        }
+    }
+
+    return false;
+}
+
+// Path vectors released by notices destroyed on one thread, kept so that
+// their memory is reused by notices subsequently materialized or copied on
+// this thread.
+class _PathVectorPool {
+  public:
+    // Maximum number of vectors kept per thread.
+    static constexpr size_t MaxVectors = 64;
+
+    // Vectors with a larger capacity are released, so that the memory kept
+    // per thread remains bounded.
+    static constexpr size_t MaxCapacity = 1024;
+
+    // Return pool of the calling thread, or nullptr if it was already
+    // destroyed as the thread exits.
+    static _PathVectorPool* Get()
+    {
+        if (_destroyed) return nullptr;
+
+        thread_local struct _Holder {
+            ~_Holder() { _destroyed = true; }
+            _PathVectorPool pool;
+        } holder;
+
+        return &holder.pool;
+    }
+
+    // Return empty vector, recycled if possible.
+    SdfPathVector Acquire()
+    {
+        if (_vectors.empty()) return SdfPathVector();
+
+        SdfPathVector paths = std::move(_vectors.back());
+        _vectors.pop_back();
+        return paths;
+    }
+
+    // Keep memory of \p paths to be recycled, if the pool is not full.
+    void Release(SdfPathVector& paths)
+    {
+        if (paths.capacity() == 0 || paths.capacity() > MaxCapacity) return;
+        if (_vectors.size() >= MaxVectors) return;
+
+        if (_vectors.capacity() == 0) {
+            _vectors.reserve(MaxVectors);
+        }
+
+        paths.clear();
+        _vectors.push_back(std::move(paths));
+    }
+
+  private:
+    std::vector<SdfPathVector> _vectors;
+
+    // Indicate whether the pool of the calling thread was destroyed.
+    static thread_local bool _destroyed;
+};
+
+thread_local bool _PathVectorPool::_destroyed = false;
+
+// Return empty path vector, recycled from the pool of the calling thread if
+// possible.
+SdfPathVector _AcquirePaths()
+{
+    auto* pool = _PathVectorPool::Get();
+    if (!pool) return SdfPathVector();
+
+    return pool->Acquire();
+}
+
+// Release memory of \p paths to the pool of the calling thread.
+void _ReleasePaths(SdfPathVector& paths)
+{
+    if (auto* pool = _PathVectorPool::Get()) {
+        pool->Release(paths);
+    }
+}
+
+}  // anonymous namespace
+
+size_t StageNotice::_GetTypeIndex(const std::type_info& type)
+{
+    static std::mutex mutex;
+    static std::unordered_map<std::type_index, size_t> indices;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Index is incremented for each new type registered.
+    auto result = indices.emplace(std::type_index(type), indices.size());
+    return result.first->second;
+}
+
 ObjectsChanged::ObjectsChanged(const UsdNotice::ObjectsChanged& notice)
+    : _source(&notice)
 {
-    // TODO: Update Usd Notice to give easier access to fields.
+}
+
+struct ObjectsChanged::_MergeCache {
+    /// Prefix tree where resynced paths are flagged.
+    SdfPathTable<bool> resynced;
+
+    /// Set of paths which are modified but not resynced.
+    SdfPathSet infoChanged;
 
-    for (const auto& path : notice.GetResyncedPaths()) {
-        _resyncChanges.push_back(path);
+    /// Record resynced \p path and indicate whether it was not recorded yet.
+    bool AddResynced(const SdfPath& path)
+    {
+        auto result = resynced.insert(std::make_pair(path, true));
+        if (result.second) return true;
 
-        auto tokens = notice.GetChangedFields(path);
-        if (tokens.size() > 0) {
-            _changedFields[path] = TfTokenSet(tokens.begin(), tokens.end());
+        // Path might have been added as the ancestor of a resynced path.
+        if (result.first->second) return false;
+        result.first->second = true;
+        return true;
+    }
+
+    /// \brief
+    /// Indicate whether \p path or one of its ancestors is resynced.
+    ///
+    /// \note
+    /// As with SdfPath::GetPrefixes, the absolute root is not considered as
+    /// an ancestor, so that modified paths are kept when the root is
+    /// resynced by layer changes.
+    bool IsResynced(const SdfPath& path) const
+    {
+        auto _isFlagged = [&](const SdfPath& target) {
+            auto it = resynced.find(target);
+            return it != resynced.end() && it->second;
+        };
+
+        if (_isFlagged(path)) return true;
+
+        const SdfPath& root = SdfPath::AbsoluteRootPath();
+        for (SdfPath ancestor = path.GetParentPath();
+             !ancestor.IsEmpty() && ancestor != root;
+             ancestor = ancestor.GetParentPath()) {
+            if (_isFlagged(ancestor)) return true;
         }
+        return false;
     }
-    for (const auto& path : notice.GetChangedInfoOnlyPaths()) {
-        _infoChanges.push_back(path);
+};
+
+struct ObjectsChanged::_FieldCache {
+    /// Sets of changed fields resolved for each path requested.
+    ChangedFieldMap fields;
+    std::mutex mutex;
+};
+
+struct ObjectsChanged::_QueryIndex {
+  private:
+    // Storage for sorted copies is declared first so that it is initialized
+    // before the references below.
+    SdfPathVector _resyncStorage;
+    SdfPathVector _infoStorage;
+
+  public:
+    _QueryIndex(
+        const SdfPathVector& resyncChanges, const SdfPathVector& infoChanges)
+        : resynced(resyncChanges.begin(), resyncChanges.end()),
+          infoChanged(infoChanges.begin(), infoChanges.end()),
+          sortedResynced(_Sort(resyncChanges, _resyncStorage)),
+          sortedInfoChanged(_Sort(infoChanges, _infoStorage))
+    {
+    }
+
+    /// Indicate whether \p path or one of its ancestors is in \p paths.
+    static bool HasPrefix(const SdfPathSet& paths, const SdfPath& path)
+    {
+        if (paths.empty()) return false;
 
-        auto tokens = notice.GetChangedFields(path);
-        if (tokens.size() > 0) {
-            _changedFields[path] = TfTokenSet(tokens.begin(), tokens.end());
+        for (SdfPath ancestor = path; !ancestor.IsEmpty();
+             ancestor = ancestor.GetParentPath()) {
+            if (paths.find(ancestor) != paths.end()) return true;
         }
+        return false;
     }
+
+    /// Hashed resynced paths.
+    SdfPathSet resynced;
+
+    /// Hashed paths which are modified but not resynced.
+    SdfPathSet infoChanged;
+
+    /// Resynced paths in lexicographical order.
+    const SdfPathVector& sortedResynced;
+
+    /// Paths modified but not resynced in lexicographical order.
+    const SdfPathVector& sortedInfoChanged;
+
+  private:
+    /// Return \p paths if already sorted, or a sorted copy within \p storage.
+    static const SdfPathVector& _Sort(
+        const SdfPathVector& paths, SdfPathVector& storage)
+    {
+        if (std::is_sorted(paths.begin(), paths.end())) return paths;
+
+        storage = paths;
+        std::sort(storage.begin(), storage.end());
+        return storage;
+    }
+};
+
+ObjectsChanged::~ObjectsChanged()
+{
+    _ResetLookups();
+
+    // Paths are recycled by notices created later on this thread.
+    _ReleasePaths(_resyncChanges);
+    _ReleasePaths(_infoChanges);
 }
 
 ObjectsChanged::ObjectsChanged(const ObjectsChanged& other)
-    : _resyncChanges(other._resyncChanges),
-      _infoChanges(other._infoChanges),
-      _changedFields(other._changedFields)
+    : _resyncChanges(_AcquirePaths()),
+      _infoChanges(_AcquirePaths()),
+      _changedFields(other._GetChangedFieldTable()),
+      _reduced(other._reduced)
 {
+    // Memory of recycled vectors is reused when paths are copied.
+    _resyncChanges = other.GetResyncedPaths();
+    _infoChanges = other.GetChangedInfoOnlyPaths();
 }
 
 ObjectsChanged& ObjectsChanged::operator=(const ObjectsChanged& other)
@@ -58,80 +283,220 @@ ObjectsChanged& ObjectsChanged::operator=(const ObjectsChanged& other)
     std::swap(_resyncChanges, copy._resyncChanges);
     std::swap(_infoChanges, copy._infoChanges);
     std::swap(_changedFields, copy._changedFields);
+    _reduced = copy._reduced;
+    _source = nullptr;
+    _mergeCache.reset();
+    _ResetLookups();
     return *this;
 }
 
 void ObjectsChanged::Merge(ObjectsChanged&& notice)
 {
-    SdfPathSet resyncSet(_resyncChanges.begin(), _resyncChanges.end());
-
-    // Update resyncChanges if necessary.
-    for (const auto& path : notice._resyncChanges) {
-        if (resyncSet.find(path) == resyncSet.end()) {
-            resyncSet.insert(path);
-            _resyncChanges.push_back(std::move(path));
-        }
-    }
+    Materialize();
+    notice.Materialize();
 
-    // Update infoChanges if necessary.
-    for (const auto& path : notice._infoChanges) {
-        const SdfPath& primPath = path.GetPrimPath();
+    _ResetLookups();
 
-        // Skip if the path is already in resyncedPaths.
-        if (resyncSet.find(primPath) != resyncSet.end()) {
-            continue;
-        }
+    // Build lookup structures once, and keep them up to date for
+    // successive merges.
+    if (!_mergeCache) {
+        _BuildMergeCache();
+    }
 
-        // Skip if an ancestor of the path is already in resyncedPaths.
-        bool ancestorResynced = false;
-        for (const auto& ancestor : primPath.GetPrefixes()) {
-            if (resyncSet.find(ancestor) != resyncSet.end()) {
-                ancestorResynced = true;
-                break;
+    auto _mergeResyncChanges = [&]() {
+        for (auto& path : notice._resyncChanges) {
+            if (_mergeCache->AddResynced(path)) {
+                _resyncChanges.push_back(std::move(path));
             }
         }
-        if (ancestorResynced) {
+    };
+
+    // Update resyncChanges first, so that modified paths beneath paths
+    // resynced by the incoming notice are skipped. If the incoming notice is
+    // an intermediate result of a reduction, its modified paths were already
+    // compared with its own resynced paths, and they are only compared with
+    // previously resynced paths so that merging remains associative.
+    if (!notice._reduced) {
+        _mergeResyncChanges();
+    }
+
+    // Update infoChanges if necessary.
+    for (auto& path : notice._infoChanges) {
+        // Skip if the path or one of its ancestors is already in
+        // resyncedPaths.
+        if (_mergeCache->IsResynced(path.GetPrimPath())) {
             continue;
         }
 
-        auto it = std::find(_infoChanges.begin(), _infoChanges.end(), path);
-        if (it == _infoChanges.end()) {
+        if (_mergeCache->infoChanged.insert(path).second) {
             _infoChanges.push_back(std::move(path));
         }
     }
 
-    // Update changeFields.
-    for (auto const& entry : notice._changedFields) {
-        auto const path = entry.first;
+    if (notice._reduced) {
+        _mergeResyncChanges();
+    }
 
-        if (_changedFields.find(path) == _changedFields.end()) {
-            _changedFields[path] = std::move(notice._changedFields[path]);
-        }
-        else {
-            _changedFields[path].insert(
-                notice._changedFields[path].begin(),
-                notice._changedFields[path].end());
-        }
+    // Update changeFields. Records are appended and coalesced as the table
+    // grows, and during post-processing.
+    _changedFields.Merge(std::move(notice._changedFields));
+}
+
+void ObjectsChanged::PrepareReduce()
+{
+    if (_reduced) return;
+
+    Materialize();
+
+    // Skip modified paths beneath paths resynced by this notice, as they
+    // would have been skipped if this notice was merged sequentially.
+    if (!_resyncChanges.empty()) {
+        _ResetLookups();
+        _BuildMergeCache();
+
+        auto& cache = *_mergeCache;
+        _infoChanges.erase(
+            std::remove_if(
+                _infoChanges.begin(),
+                _infoChanges.end(),
+                [&](const SdfPath& path) {
+                    if (!cache.IsResynced(path.GetPrimPath())) return false;
+                    cache.infoChanged.erase(path);
+                    return true;
+                }),
+            _infoChanges.end());
     }
+
+    _reduced = true;
 }
 
 void ObjectsChanged::PostProcess()
 {
+    Materialize();
+
     SdfPath::RemoveDescendentPaths(&_resyncChanges);
+    _changedFields.Consolidate();
+
+    // Release lookup structures as no more merge is expected.
+    _mergeCache.reset();
+    _ResetLookups();
+}
+
+void ObjectsChanged::Materialize()
+{
+    if (!_source) return;
+
+    _MaterializePaths();
+    _MaterializeFields();
+    _source = nullptr;
+}
+
+bool ObjectsChanged::Restrict(const SdfPathVector& prefixes)
+{
+    Materialize();
+
+    _mergeCache.reset();
+    _ResetLookups();
+
+    SdfPathVector resyncChanges = _AcquirePaths();
+    for (auto& path : _resyncChanges) {
+        for (const auto& prefix : prefixes) {
+            if (path.HasPrefix(prefix)) {
+                resyncChanges.push_back(std::move(path));
+                break;
+            }
+
+            // Resyncing an ancestor resyncs the entire subtree in scope.
+            if (prefix.HasPrefix(path)) {
+                resyncChanges.push_back(prefix);
+            }
+        }
+    }
+
+    // Prefixes might be recorded several times if several ancestors were
+    // resynced.
+    std::sort(resyncChanges.begin(), resyncChanges.end());
+    resyncChanges.erase(
+        std::unique(resyncChanges.begin(), resyncChanges.end()),
+        resyncChanges.end());
+
+    _ReleasePaths(_resyncChanges);
+    _resyncChanges = std::move(resyncChanges);
+
+    _infoChanges.erase(
+        std::remove_if(
+            _infoChanges.begin(),
+            _infoChanges.end(),
+            [&](const SdfPath& path) {
+                return std::none_of(
+                    prefixes.begin(),
+                    prefixes.end(),
+                    [&](const SdfPath& prefix) {
+                        return path.HasPrefix(prefix);
+                    });
+            }),
+        _infoChanges.end());
+
+    _changedFields.Restrict(prefixes);
+
+    return !_resyncChanges.empty() || !_infoChanges.empty();
+}
+
+bool ObjectsChanged::AffectsPaths(const SdfPathVector& prefixes) const
+{
+    // Evaluate paths from originating notice to avoid copying them.
+    if (_source) {
+        return _AffectsPaths(
+            _source->GetResyncedPaths(),
+            _source->GetChangedInfoOnlyPaths(),
+            prefixes);
+    }
+
+    return _AffectsPaths(_resyncChanges, _infoChanges, prefixes);
 }
 
 bool ObjectsChanged::ResyncedObject(const PXR_NS::UsdObject& object) const
 {
-    auto path = PXR_NS::SdfPathFindLongestPrefix(
-        _resyncChanges.begin(), _resyncChanges.end(), object.GetPath());
-    return path != _resyncChanges.end();
+    if (_source) return _source->ResyncedObject(object);
+
+    return _QueryIndex::HasPrefix(
+        _GetQueryIndex().resynced, object.GetPath());
 }
 
 bool ObjectsChanged::ChangedInfoOnly(const PXR_NS::UsdObject& object) const
 {
-    auto path = PXR_NS::SdfPathFindLongestPrefix(
-        _infoChanges.begin(), _infoChanges.end(), object.GetPath());
-    return path != _infoChanges.end();
+    if (_source) return _source->ChangedInfoOnly(object);
+
+    return _QueryIndex::HasPrefix(
+        _GetQueryIndex().infoChanged, object.GetPath());
+}
+
+const SdfPathVector& ObjectsChanged::GetResyncedPaths() const
+{
+    _MaterializePaths();
+    return _resyncChanges;
+}
+
+const SdfPathVector& ObjectsChanged::GetChangedInfoOnlyPaths() const
+{
+    _MaterializePaths();
+    return _infoChanges;
+}
+
+ObjectsChanged::PathRange ObjectsChanged::FindResyncedPaths(
+    const SdfPath& root) const
+{
+    const auto& paths = _GetQueryIndex().sortedResynced;
+    auto range = SdfPathFindPrefixedRange(paths.begin(), paths.end(), root);
+    return PathRange(range.first, range.second);
+}
+
+ObjectsChanged::PathRange ObjectsChanged::FindChangedInfoOnlyPaths(
+    const SdfPath& root) const
+{
+    const auto& paths = _GetQueryIndex().sortedInfoChanged;
+    auto range = SdfPathFindPrefixedRange(paths.begin(), paths.end(), root);
+    return PathRange(range.first, range.second);
 }
 
 TfTokenSet ObjectsChanged::GetChangedFields(
@@ -142,10 +507,55 @@ TfTokenSet ObjectsChanged::GetChangedFields(
 
 TfTokenSet ObjectsChanged::GetChangedFields(const PXR_NS::SdfPath& path) const
 {
-    if (HasChangedFields(path)) {
-        return _changedFields.at(path);
+    // Only convert fields for requested path when data is referenced.
+    if (_source) {
+        auto tokens = _source->GetChangedFields(path);
+        return TfTokenSet(tokens.begin(), tokens.end());
+    }
+
+    return _changedFields.Get(path);
+}
+
+const TfTokenSet& ObjectsChanged::GetChangedFieldsRef(
+    const UsdObject& object) const
+{
+    return GetChangedFieldsRef(object.GetPath());
+}
+
+const TfTokenSet& ObjectsChanged::GetChangedFieldsRef(const SdfPath& path) const
+{
+    static const TfTokenSet empty;
+
+    // Use map of all changed fields if it was already expanded.
+    if (const ChangedFieldMap* map =
+            _changedFieldMap.load(std::memory_order_acquire)) {
+        auto it = map->find(path);
+        return it != map->end() ? it->second : empty;
+    }
+
+    if (!HasChangedFields(path)) return empty;
+
+    _FieldCache* cache = _changedFieldCache.load(std::memory_order_acquire);
+    if (!cache) {
+        // Concurrent calls might create the cache simultaneously, in which
+        // case only the first one recorded is kept.
+        std::unique_ptr<_FieldCache> newCache(new _FieldCache());
+
+        if (_changedFieldCache.compare_exchange_strong(
+                cache, newCache.get(), std::memory_order_acq_rel)) {
+            cache = newCache.release();
+        }
+    }
+
+    // Only fields of requested path are resolved. Elements of the map are
+    // not moved when it grows, so references returned remain valid.
+    std::lock_guard<std::mutex> lock(cache->mutex);
+
+    auto it = cache->fields.find(path);
+    if (it == cache->fields.end()) {
+        it = cache->fields.emplace(path, GetChangedFields(path)).first;
     }
-    return TfTokenSet();
+    return it->second;
 }
 
 bool ObjectsChanged::HasChangedFields(const UsdObject& object) const
@@ -155,11 +565,102 @@ bool ObjectsChanged::HasChangedFields(const UsdObject& object) const
 
 bool ObjectsChanged::HasChangedFields(const SdfPath& path) const
 {
-    if (_changedFields.find(path) != _changedFields.end()) {
-        return true;
+    if (_source) return _source->HasChangedFields(path);
+
+    return _changedFields.Has(path);
+}
+
+const ChangedFieldMap& ObjectsChanged::GetChangedFieldMap() const
+{
+    ChangedFieldMap* map = _changedFieldMap.load(std::memory_order_acquire);
+    if (map) return *map;
+
+    // Concurrent calls might build the map simultaneously, in which case
+    // only the first one recorded is kept.
+    std::unique_ptr<ChangedFieldMap> newMap(
+        new ChangedFieldMap(_GetChangedFieldTable().GetMap()));
+
+    if (_changedFieldMap.compare_exchange_strong(
+            map, newMap.get(), std::memory_order_acq_rel)) {
+        return *newMap.release();
     }
 
-    return false;
+    return *map;
+}
+
+void ObjectsChanged::_BuildMergeCache()
+{
+    _mergeCache.reset(new _MergeCache());
+
+    for (const auto& path : _resyncChanges) {
+        _mergeCache->AddResynced(path);
+    }
+    _mergeCache->infoChanged.insert(_infoChanges.begin(), _infoChanges.end());
+}
+
+void ObjectsChanged::_MaterializePaths() const
+{
+    if (!_source) return;
+
+    std::call_once(_pathsFlag, [&]() {
+        const auto resyncedPaths = _source->GetResyncedPaths();
+        _resyncChanges = _AcquirePaths();
+        _resyncChanges.assign(resyncedPaths.begin(), resyncedPaths.end());
+
+        const auto infoPaths = _source->GetChangedInfoOnlyPaths();
+        _infoChanges = _AcquirePaths();
+        _infoChanges.assign(infoPaths.begin(), infoPaths.end());
+    });
+}
+
+void ObjectsChanged::_MaterializeFields() const
+{
+    if (!_source) return;
+
+    std::call_once(_fieldsFlag, [&]() {
+        auto _insert = [&](const UsdNotice::ObjectsChanged::PathRange& range) {
+            for (auto it = range.begin(); it != range.end(); ++it) {
+                _changedFields.Add(*it, it.GetChangedFields());
+            }
+        };
+
+        _insert(_source->GetResyncedPaths());
+        _insert(_source->GetChangedInfoOnlyPaths());
+        _changedFields.Consolidate();
+    });
+}
+
+const ChangedFieldTable& ObjectsChanged::_GetChangedFieldTable() const
+{
+    _MaterializeFields();
+    return _changedFields;
+}
+
+const ObjectsChanged::_QueryIndex& ObjectsChanged::_GetQueryIndex() const
+{
+    _MaterializePaths();
+
+    _QueryIndex* index = _queryIndex.load(std::memory_order_acquire);
+    if (index) return *index;
+
+    // Concurrent queries might build the index simultaneously, in which
+    // case only the first one recorded is kept.
+    std::unique_ptr<_QueryIndex> newIndex(
+        new _QueryIndex(_resyncChanges, _infoChanges));
+
+    if (_queryIndex.compare_exchange_strong(
+            index, newIndex.get(), std::memory_order_acq_rel)) {
+        return *newIndex.release();
+    }
+
+    return *index;
+}
+
+void ObjectsChanged::_ResetLookups()
+{
+    delete _queryIndex.exchange(nullptr, std::memory_order_acq_rel);
+    delete _changedFieldMap.exchange(nullptr, std::memory_order_acq_rel);
+    delete _changedFieldCache.exchange(nullptr, std::memory_order_acq_rel);
 }
 
 LayerMutingChanged::LayerMutingChanged(
@@ -4,6 +4,7 @@
 /// \file unf/notice.h
 
 #include "unf/api.h"
+#include "unf/changedFieldTable.h"
 
 #include <pxr/base/arch/demangle.h>
 #include <pxr/base/tf/notice.h>
@@ -13,23 +14,18 @@
 #include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usd/notice.h>
 
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <typeinfo>
 #include <vector>
 
 namespace unf {
 
-/// Convenient alias for set of tokens.
-using TfTokenSet =
-    std::unordered_set<PXR_NS::TfToken, PXR_NS::TfToken::HashFunctor>;
-
-/// Convenient alias for set of paths.
-using SdfPathSet = std::unordered_set<PXR_NS::SdfPath, PXR_NS::SdfPath::Hash>;
-
-/// Convenient alias for map of token sets organized per path.
-using ChangedFieldMap =
-    std::unordered_map<PXR_NS::SdfPath, TfTokenSet, PXR_NS::SdfPath::Hash>;
+class CapturePredicate;
 
 namespace UnfNotice {
 
@@ -58,6 +54,35 @@ class StageNotice : public PXR_NS::TfNotice, public PXR_NS::TfRefBase {
     /// \sa NoticeTransaction
     UNF_API virtual bool IsMergeable() const { return true; }
 
+    /// \brief
+    /// Indicate whether merging notices from the same type is associative.
+    ///
+    /// When true, a large number of notices captured during a transaction
+    /// can be merged by pairs concurrently instead of being folded one by one
+    /// into the first notice. Merging must then yield the same result
+    /// regardless of how merges are grouped, as long as the order of
+    /// notices is preserved.
+    ///
+    /// By default, this method return false.
+    ///
+    /// \sa Merge
+    /// \sa PrepareReduce
+    /// \sa Broker::SetParallelThreshold
+    UNF_API virtual bool IsMergeAssociative() const { return false; }
+
+    /// \brief
+    /// Base method for preparing notice to be merged within a concurrent
+    /// reduction.
+    ///
+    /// Called on each notice but the first one before it is merged or used
+    /// as an intermediate result, so that the reduction yields the same
+    /// result as merging notices one by one into the first notice.
+    ///
+    /// By default, no process is done.
+    ///
+    /// \sa IsMergeAssociative
+    virtual void PrepareReduce() {}
+
     /// \brief
     /// Interface method for merging StageNotice.
     ///
@@ -76,6 +101,32 @@ class StageNotice : public PXR_NS::TfNotice, public PXR_NS::TfRefBase {
     /// By default, no process is done.
     virtual void PostProcess() {}
 
+    /// \brief
+    /// Base method for ensuring that the notice owns all of its data.
+    ///
+    /// Notices can reference data from the notice they were created from
+    /// while it is delivered synchronously. This method is called when the
+    /// notice needs to outlive this delivery, such as when it is captured
+    /// within a transaction.
+    ///
+    /// By default, no process is done.
+    virtual void Materialize() {}
+
+    /// \brief
+    /// Base method for removing content outside of \p prefixes.
+    ///
+    /// This method is called when the notice is captured within a
+    /// transaction restricted to a set of subtrees, before it is merged.
+    /// Return false if the notice has no content left and can be discarded.
+    ///
+    /// By default, no content is removed and true is returned.
+    ///
+    /// \sa Broker::BeginTransaction
+    virtual bool Restrict(const PXR_NS::SdfPathVector& prefixes)
+    {
+        return true;
+    }
+
     /// \brief
     /// Interface method for returing unique type identifier.
     ///
@@ -89,6 +140,23 @@ class StageNotice : public PXR_NS::TfNotice, public PXR_NS::TfRefBase {
         return "";
     }
 
+    /// \brief
+    /// Interface method for returning unique type index.
+    ///
+    /// Contrary to GetTypeId, the index is a small integer assigned once per
+    /// notice type for the lifetime of the process, which makes it cheap to
+    /// compare and suitable for addressing flat containers.
+    ///
+    /// \warning
+    /// This method should be considered as pure virtual.
+    UNF_API virtual size_t GetTypeIndex() const
+    {
+        PXR_NAMESPACE_USING_DIRECTIVE
+        TF_FATAL_ERROR(
+            "Abstract class 'StageNotice' does not have a unique index.");
+        return 0;
+    }
+
     /// \brief
     /// Interface method to return a copy of the notice.
     ///
@@ -102,6 +170,15 @@ class StageNotice : public PXR_NS::TfNotice, public PXR_NS::TfRefBase {
   protected:
     UNF_API StageNotice() = default;
 
+    /// Predicates resolve notice types into type indices.
+    friend class unf::CapturePredicate;
+
+    /// \brief
+    /// Return unique index associated with \p type.
+    ///
+    /// A new index is registered the first time a type is queried.
+    UNF_API static size_t _GetTypeIndex(const std::type_info& type);
+
   private:
     /// \brief
     /// Interface to return a raw pointer to a copy of the notice.
@@ -160,9 +237,15 @@ class StageNoticeImpl : public StageNotice {
         return PXR_NS::TfCreateRefPtr(static_cast<Self*>(_Clone()));
     }
 
+    /// \brief
+    /// Merge notice with another notice of the same type.
+    ///
+    /// \warning
+    /// Incoming \p notice must be of type \p Self. This is guaranteed by the
+    /// Broker which groups notices per type index before merging.
     virtual void Merge(StageNotice&& notice) override
     {
-        Merge(dynamic_cast<Self&&>(notice));
+        Merge(static_cast<Self&&>(notice));
     }
 
     /// \brief
@@ -180,6 +263,22 @@ class StageNoticeImpl : public StageNotice {
         return PXR_NS::ArchGetDemangled(typeid(Self).name());
     }
 
+    /// \brief
+    /// Return unique index associated with notice type.
+    ///
+    /// The index is resolved once per type and cached.
+    static size_t GetStaticTypeIndex()
+    {
+        static const size_t index = _GetTypeIndex(typeid(Self));
+        return index;
+    }
+
+    /// Base method for returning unique type index.
+    virtual size_t GetTypeIndex() const override
+    {
+        return GetStaticTypeIndex();
+    }
+
   private:
     /// \brief
     /// Return a raw pointer to a copy of the notice.
@@ -226,7 +325,40 @@ class StageContentsChanged : public StageNoticeImpl<StageContentsChanged> {
 /// PXR_NS::UsdNotice::ObjectsChanged notice type.
 class ObjectsChanged : public StageNoticeImpl<ObjectsChanged> {
   public:
-    UNF_API virtual ~ObjectsChanged() = default;
+    /// \class PathRange
+    ///
+    /// \brief
+    /// Range of paths in lexicographical order.
+    ///
+    /// \warning
+    /// The range is invalidated when the notice is modified or destroyed.
+    class PathRange {
+      public:
+        using const_iterator = PXR_NS::SdfPathVector::const_iterator;
+
+        PathRange(const_iterator begin, const_iterator end)
+            : _begin(begin), _end(end)
+        {
+        }
+
+        /// Return iterator to the first path of the range.
+        const_iterator begin() const { return _begin; }
+
+        /// Return iterator past the last path of the range.
+        const_iterator end() const { return _end; }
+
+        /// Indicate whether the range is empty.
+        bool empty() const { return _begin == _end; }
+
+        /// Return number of paths within the range.
+        size_t size() const { return std::distance(_begin, _end); }
+
+      private:
+        const_iterator _begin;
+        const_iterator _end;
+    };
+
+    UNF_API virtual ~ObjectsChanged();
 
     /// Copy constructor.
     UNF_API ObjectsChanged(const ObjectsChanged&);
@@ -246,6 +378,36 @@ class ObjectsChanged : public StageNoticeImpl<ObjectsChanged> {
     UNF_API virtual void Merge(ObjectsChanged&&) override;
     UNF_API virtual void PostProcess() override;
 
+    /// \brief
+    /// Indicate that merging ObjectsChanged notices is associative.
+    ///
+    /// \note
+    /// Once post-processed, notices merged in any grouping record the same
+    /// paths in the same order.
+    UNF_API virtual bool IsMergeAssociative() const override { return true; }
+
+    /// \brief
+    /// Skip modified paths beneath paths resynced by this notice.
+    ///
+    /// Modified paths of a prepared notice are only compared with paths
+    /// resynced by previously merged notices when it is merged, so that
+    /// merging remains associative.
+    UNF_API virtual void PrepareReduce() override;
+
+    /// \brief
+    /// Copy data referenced from the originating
+    /// PXR_NS::UsdNotice::ObjectsChanged notice if necessary.
+    UNF_API virtual void Materialize() override;
+
+    /// \brief
+    /// Remove paths and changed fields outside of \p prefixes.
+    ///
+    /// Resynced paths which are ancestors of a prefix are replaced by the
+    /// prefix, as the entire subtree in scope is resynced. Return false if
+    /// no paths are left.
+    UNF_API virtual bool Restrict(const PXR_NS::SdfPathVector& prefixes)
+        override;
+
     /// \brief
     /// Indicate whether \p object was affected by the change that generated
     /// this notice.
@@ -257,6 +419,19 @@ class ObjectsChanged : public StageNoticeImpl<ObjectsChanged> {
         return ResyncedObject(object) || ChangedInfoOnly(object);
     }
 
+    /// \brief
+    /// Indicate whether the change that generated this notice affected any
+    /// of \p prefixes.
+    ///
+    /// A prefix is affected when a path resynced is a prefix or a descendant
+    /// of it, or when a path modified without being resynced is a descendant
+    /// of it.
+    ///
+    /// \note
+    /// Data referenced from the originating
+    /// PXR_NS::UsdNotice::ObjectsChanged notice is not copied.
+    UNF_API bool AffectsPaths(const PXR_NS::SdfPathVector& prefixes) const;
+
     /// \brief
     /// Indicate whether \p object was resynced by the change that generated
     /// this notice.
@@ -278,10 +453,7 @@ class ObjectsChanged : public StageNoticeImpl<ObjectsChanged> {
     ///
     /// \note
     /// Equivalent from PXR_NS::UsdNotice::ObjectsChanged::GetResyncedPaths
-    UNF_API const PXR_NS::SdfPathVector& GetResyncedPaths() const
-    {
-        return _resyncChanges;
-    }
+    UNF_API const PXR_NS::SdfPathVector& GetResyncedPaths() const;
 
     /// \brief
     /// Return vector of paths that are modified but not resynced in
@@ -290,10 +462,18 @@ class ObjectsChanged : public StageNoticeImpl<ObjectsChanged> {
     /// \note
     /// Equivalent from
     /// PXR_NS::UsdNotice::ObjectsChanged::GetChangedInfoOnlyPaths
-    UNF_API const PXR_NS::SdfPathVector& GetChangedInfoOnlyPaths() const
-    {
-        return _infoChanges;
-    }
+    UNF_API const PXR_NS::SdfPathVector& GetChangedInfoOnlyPaths() const;
+
+    /// \brief
+    /// Return range of resynced paths which are \p root or its descendants,
+    /// in lexicographical order.
+    UNF_API PathRange FindResyncedPaths(const PXR_NS::SdfPath& root) const;
+
+    /// \brief
+    /// Return range of paths modified but not resynced which are \p root or
+    /// its descendants, in lexicographical order.
+    UNF_API PathRange
+    FindChangedInfoOnlyPaths(const PXR_NS::SdfPath& root) const;
 
     /// \brief
     /// Return the set of changed fields in layers that affected the \p object.
@@ -313,6 +493,33 @@ class ObjectsChanged : public StageNoticeImpl<ObjectsChanged> {
     /// const
     UNF_API TfTokenSet GetChangedFields(const PXR_NS::SdfPath&) const;
 
+    /// \brief
+    /// Return reference to the set of changed fields in layers that affected
+    /// the \p object.
+    ///
+    /// \sa GetChangedFieldsRef(const PXR_NS::SdfPath&) const
+    UNF_API const TfTokenSet& GetChangedFieldsRef(
+        const PXR_NS::UsdObject&) const;
+
+    /// \brief
+    /// Return reference to the set of changed fields in layers that affected
+    /// the \p path.
+    ///
+    /// Contrary to GetChangedFields, the set is not copied on successive
+    /// calls. An empty set is returned if no fields were changed for
+    /// \p path.
+    ///
+    /// \note
+    /// The set is resolved from the ChangedFieldTable on first call for
+    /// \p path and cached within the notice, unless GetChangedFieldMap
+    /// was called, in which case the set is returned from the map.
+    ///
+    /// \warning
+    /// The reference returned is invalidated when the notice is modified,
+    /// such as when another notice is merged into it or when it is
+    /// post-processed, and when the notice is destroyed.
+    UNF_API const TfTokenSet& GetChangedFieldsRef(const PXR_NS::SdfPath&) const;
+
     /// \brief
     /// Indicate whether any changed fields affected the \p object.
     ///
@@ -333,24 +540,110 @@ class ObjectsChanged : public StageNoticeImpl<ObjectsChanged> {
 
     /// \brief
     /// Return map of affected token sets organized per path.
-    const ChangedFieldMap& GetChangedFieldMap() const { return _changedFields; }
+    ///
+    /// \note
+    /// Changed fields are recorded in a compact ChangedFieldTable, so the
+    /// map is built on first call and kept until the notice is modified.
+    UNF_API const ChangedFieldMap& GetChangedFieldMap() const;
 
   protected:
+    /// \brief
     /// Create notice from PXR_NS::UsdNotice::ObjectsChanged instance.
+    ///
+    /// Data is not copied from the incoming \p notice, but referenced until
+    /// it is required or until the notice is copied or materialized.
+    ///
+    /// \warning
+    /// The incoming \p notice must outlive this notice unless Materialize is
+    /// called. The Broker materializes every notice it captures, and
+    /// Dispatcher materializes notices still referenced after delivery.
     explicit ObjectsChanged(const PXR_NS::UsdNotice::ObjectsChanged&);
 
     /// Ensure that StageNoticeImpl::Create method can call constructor.
     friend StageNoticeImpl<ObjectsChanged>;
 
   private:
+    /// Copy paths from originating notice if necessary.
+    void _MaterializePaths() const;
+
+    /// Copy changed fields from originating notice if necessary.
+    void _MaterializeFields() const;
+
+    /// Return table of changed fields, copying it first if necessary.
+    const ChangedFieldTable& _GetChangedFieldTable() const;
+
+    /// \brief
+    /// Originating notice referenced until data is materialized.
+    ///
+    /// \note
+    /// Containers below are mutable as they are filled on demand from this
+    /// notice.
+    const PXR_NS::UsdNotice::ObjectsChanged* _source = nullptr;
+
+    /// Flag ensuring that paths are copied only once.
+    mutable std::once_flag _pathsFlag;
+
+    /// Flag ensuring that changed fields are copied only once.
+    mutable std::once_flag _fieldsFlag;
+
     /// List of resynced paths.
-    PXR_NS::SdfPathVector _resyncChanges;
+    mutable PXR_NS::SdfPathVector _resyncChanges;
 
     /// List of paths which are modified but not resynced.
-    PXR_NS::SdfPathVector _infoChanges;
+    mutable PXR_NS::SdfPathVector _infoChanges;
+
+    /// Table of affected fields organized per path.
+    mutable ChangedFieldTable _changedFields;
+
+    /// \brief
+    /// Lookup structures maintained across successive merges.
+    ///
+    /// \note
+    /// Built on first merge and released after post-processing. It is not
+    /// copied with the notice as it can be rebuilt from the path vectors.
+    struct _MergeCache;
+    std::unique_ptr<_MergeCache> _mergeCache;
+
+    /// \brief
+    /// Immutable lookup structures used to answer queries.
+    ///
+    /// \note
+    /// Built on first query and released when the notice is modified.
+    struct _QueryIndex;
+    mutable std::atomic<_QueryIndex*> _queryIndex{nullptr};
+
+    /// \brief
+    /// Map of affected token sets expanded from the changed field table.
+    ///
+    /// \note
+    /// Built on first call to GetChangedFieldMap and released when the
+    /// notice is modified.
+    mutable std::atomic<ChangedFieldMap*> _changedFieldMap{nullptr};
+
+    /// \brief
+    /// Sets of changed fields resolved for paths requested individually.
+    ///
+    /// \note
+    /// Created on first call to GetChangedFieldsRef and released when the
+    /// notice is modified.
+    struct _FieldCache;
+    mutable std::atomic<_FieldCache*> _changedFieldCache{nullptr};
+
+    /// \brief
+    /// Indicate whether modified paths were compared with resynced paths
+    /// of this notice in preparation of a reduction.
+    ///
+    /// \sa PrepareReduce
+    bool _reduced = false;
+
+    /// Build lookup structures maintained across successive merges.
+    void _BuildMergeCache();
+
+    /// Return query index, building it if necessary.
+    const _QueryIndex& _GetQueryIndex() const;
 
-    /// Map of affected token sets organized per path.
-    ChangedFieldMap _changedFields;
+    /// Release query index and maps of changed fields.
+    void _ResetLookups();
 };
 
 /// \class StageEditTargetChanged
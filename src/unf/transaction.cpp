@@ -3,6 +3,7 @@
 #include "unf/capturePredicate.h"
 
 #include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usd/common.h>
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -23,6 +24,15 @@ NoticeTransaction::NoticeTransaction(
     _broker->BeginTransaction(predicate);
 }
 
+NoticeTransaction::NoticeTransaction(
+    const BrokerPtr& broker,
+    const SdfPathVector& scope,
+    CapturePredicate predicate)
+    : _broker(broker)
+{
+    _broker->BeginTransaction(scope, predicate);
+}
+
 NoticeTransaction::NoticeTransaction(
     const UsdStageRefPtr& stage, CapturePredicate predicate)
     : _broker(Broker::Create(stage))
@@ -37,6 +47,15 @@ NoticeTransaction::NoticeTransaction(
     _broker->BeginTransaction(predicate);
 }
 
+NoticeTransaction::NoticeTransaction(
+    const UsdStageRefPtr& stage,
+    const SdfPathVector& scope,
+    CapturePredicate predicate)
+    : _broker(Broker::Create(stage))
+{
+    _broker->BeginTransaction(scope, predicate);
+}
+
 NoticeTransaction::~NoticeTransaction() { _broker->EndTransaction(); }
 
 }  // namespace unf
@@ -8,6 +8,7 @@
 #include "unf/capturePredicate.h"
 
 #include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usd/common.h>
 
 namespace unf {
@@ -47,6 +48,23 @@ class NoticeTransaction {
     /// \endcode
     UNF_API NoticeTransaction(const BrokerPtr &, const CapturePredicateFunc &);
 
+    /// \brief
+    /// Create transaction from a Broker restricted to a set of subtrees.
+    ///
+    /// Captured notices are trimmed to the content under \p scope, and
+    /// notices with no content left are discarded.
+    ///
+    /// \code{.cpp}
+    /// NoticeTransaction t(broker, {pxr::SdfPath("/World/Character")});
+    /// \endcode
+    ///
+    /// \sa Broker::BeginTransaction(const PXR_NS::SdfPathVector&,
+    /// CapturePredicate)
+    UNF_API NoticeTransaction(
+        const BrokerPtr &,
+        const PXR_NS::SdfPathVector &scope,
+        CapturePredicate predicate = CapturePredicate::Default());
+
     /// \brief
     /// Create transaction from a UsdStage.
     ///
@@ -70,6 +88,19 @@ class NoticeTransaction {
     UNF_API NoticeTransaction(
         const PXR_NS::UsdStageRefPtr &, const CapturePredicateFunc &);
 
+    /// \brief
+    /// Create transaction from a UsdStage restricted to a set of subtrees.
+    ///
+    /// Convenient constructor to encapsulate the creation of the broker.
+    ///
+    /// \sa
+    /// NoticeTransaction(const BrokerPtr &, const PXR_NS::SdfPathVector &,
+    /// CapturePredicate predicate = CapturePredicate::Default())
+    UNF_API NoticeTransaction(
+        const PXR_NS::UsdStageRefPtr &,
+        const PXR_NS::SdfPathVector &scope,
+        CapturePredicate predicate = CapturePredicate::Default());
+
     /// Delete object and end transaction.
     UNF_API virtual ~NoticeTransaction();
 
@@ -1,6 +1,6 @@
 # -*- coding: utf-8 -*-
 
-from pxr import Usd
+from pxr import Usd, Tf
 import unf
 
 
@@ -51,3 +51,186 @@ def test_broker_transaction_nested():
     broker.EndTransaction()
     assert broker.IsInTransaction() is False
 
+
+def test_broker_streaming_merge():
+    """Consolidate notices as soon as they are captured."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+    assert broker.IsStreamingMerge() is False
+
+    broker.SetStreamingMerge(True)
+    assert broker.IsStreamingMerge() is True
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    broker.BeginTransaction()
+    stage.DefinePrim("/Foo")
+    stage.DefinePrim("/Bar")
+    broker.EndTransaction()
+
+    # Ensure that one consolidated notice was received.
+    assert len(received) == 1
+    assert received[0].GetResyncedPaths() == ["/Bar", "/Foo"]
+
+def test_broker_parallel_threshold():
+    """Consolidate notice types concurrently."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+    assert broker.GetParallelThreshold() == 0
+
+    broker.SetParallelThreshold(1)
+    assert broker.GetParallelThreshold() == 1
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    broker.BeginTransaction()
+    stage.DefinePrim("/Foo")
+    stage.DefinePrim("/Bar")
+    stage.SetEditTarget(stage.GetSessionLayer())
+    broker.EndTransaction()
+
+    # Ensure that one consolidated notice was received.
+    assert len(received) == 1
+    assert received[0].GetResyncedPaths() == ["/Bar", "/Foo"]
+
+def test_broker_transaction_budget():
+    """Consolidate notices during transaction once budget is exhausted."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+    assert broker.GetTransactionBudget() == 0
+
+    broker.SetTransactionBudget(2)
+    assert broker.GetTransactionBudget() == 2
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    broker.BeginTransaction()
+    stage.DefinePrim("/Foo")
+    stage.DefinePrim("/Bar")
+    stage.DefinePrim("/Baz")
+    broker.EndTransaction()
+
+    # Ensure that one consolidated notice was received.
+    assert len(received) == 1
+    assert received[0].GetResyncedPaths() == ["/Bar", "/Baz", "/Foo"]
+
+def test_broker_transaction_with_scope():
+    """Restrict notices captured within a transaction to subtrees."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    broker.BeginTransaction(["/Foo"])
+    stage.DefinePrim("/Foo")
+    stage.DefinePrim("/Foo/Bar")
+    stage.DefinePrim("/Baz")
+    broker.EndTransaction()
+
+    # Ensure that changes outside of the scope were trimmed.
+    assert len(received) == 1
+    assert received[0].GetResyncedPaths() == ["/Foo"]
+
+    # Ensure that notices left without changes are not emitted.
+    broker.BeginTransaction(
+        scope=["/Foo"], predicate=unf.CapturePredicate.Default()
+    )
+    stage.DefinePrim("/Bim")
+    broker.EndTransaction()
+
+    assert len(received) == 1
+
+
+def test_broker_thread_local_transactions():
+    """Capture notices within transactions local to each thread."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+    assert broker.IsThreadLocalTransactions() is False
+
+    broker.SetThreadLocalTransactions(True)
+    assert broker.IsThreadLocalTransactions() is True
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    broker.BeginTransaction()
+    assert broker.IsInTransaction() is True
+
+    stage.DefinePrim("/Foo")
+    stage.DefinePrim("/Bar")
+
+    broker.EndTransaction()
+    assert broker.IsInTransaction() is False
+
+    # Ensure that one consolidated notice was received.
+    assert len(received) == 1
+    assert received[0].GetResyncedPaths() == ["/Bar", "/Foo"]
+
+def test_broker_auto_batching():
+    """Batch notices sent outside of transactions."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+    assert broker.IsAutoBatching() is False
+    assert broker.GetAutoBatchThreshold() == 0
+    assert broker.GetAutoBatchInterval() == 0.0
+
+    broker.SetAutoBatching(True)
+    assert broker.IsAutoBatching() is True
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    stage.DefinePrim("/Foo")
+    stage.DefinePrim("/Bar")
+    assert len(received) == 0
+
+    broker.Tick()
+
+    # Ensure that one consolidated notice was received.
+    assert len(received) == 1
+    assert received[0].GetResyncedPaths() == ["/Bar", "/Foo"]
+
+    # Each prim definition emits "StageContentsChanged" and "ObjectsChanged".
+    broker.SetAutoBatchThreshold(4)
+    assert broker.GetAutoBatchThreshold() == 4
+
+    stage.DefinePrim("/Baz")
+    assert len(received) == 1
+
+    stage.DefinePrim("/Bim")
+    assert len(received) == 2
+    assert received[1].GetResyncedPaths() == ["/Baz", "/Bim"]
@@ -164,3 +164,77 @@ def test_objects_changed_has_changed_fields():
 
     # Ensure that one notice was received.
     assert len(received) == 1
+
+
+def test_objects_changed_find_resynced_paths():
+    """Return resynced paths within a subtree."""
+    stage = Usd.Stage.CreateInMemory()
+    unf.Broker.Create(stage)
+
+    stage.DefinePrim("/Foo")
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        assert notice.FindResyncedPaths(Sdf.Path("/Foo")) == ["/Foo/Bar"]
+        assert notice.FindResyncedPaths(Sdf.Path("/Bim")) == []
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    stage.DefinePrim("/Foo/Bar")
+
+    # Ensure that one notice was received.
+    assert len(received) == 1
+
+
+def test_objects_changed_find_changed_info_only_paths():
+    """Return paths modified but not resynced within a subtree."""
+    stage = Usd.Stage.CreateInMemory()
+    unf.Broker.Create(stage)
+
+    prim = stage.DefinePrim("/Foo")
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        assert notice.FindChangedInfoOnlyPaths(Sdf.Path("/Foo")) == ["/Foo"]
+        assert notice.FindChangedInfoOnlyPaths(Sdf.Path("/Bim")) == []
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    prim.SetMetadata("comment", "This is a test")
+
+    # Ensure that one notice was received.
+    assert len(received) == 1
+
+
+def test_objects_changed_cached_paths():
+    """Return equal lists of paths for successive calls."""
+    stage = Usd.Stage.CreateInMemory()
+    unf.Broker.Create(stage)
+
+    prim = stage.DefinePrim("/Foo")
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        assert notice.GetResyncedPaths() == notice.GetResyncedPaths()
+        assert notice.GetChangedInfoOnlyPaths() == [Sdf.Path("/Foo")]
+
+        # Modifying the list returned does not affect subsequent calls.
+        paths = notice.GetChangedInfoOnlyPaths()
+        paths.clear()
+        assert notice.GetChangedInfoOnlyPaths() == [Sdf.Path("/Foo")]
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    prim.SetMetadata("comment", "This is a test")
+
+    # Ensure that one notice was received.
+    assert len(received) == 1
@@ -1,6 +1,6 @@
 # -*- coding: utf-8 -*-
 
-from pxr import Usd, Tf
+from pxr import Usd, Sdf, Tf
 import unf
 
 
@@ -121,6 +121,168 @@ def test_transaction_create_from_broker_with_blockall_predicate():
     # Ensure that no notices were received.
     assert len(received) == 0
 
+def test_transaction_create_from_broker_with_type_predicate():
+    """Create a transaction and only capture some notice types."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    key1 = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+    key2 = Tf.Notice.Register(
+        unf.Notice.StageContentsChanged, _validate, stage
+    )
+
+    predicate = unf.CapturePredicate.AllowTypes([unf.Notice.ObjectsChanged])
+
+    with unf.NoticeTransaction(broker, predicate=predicate):
+        stage.DefinePrim("/Foo")
+
+    # Ensure that only ObjectsChanged notice was received.
+    assert len(received) == 1
+    assert isinstance(received[0], unf.Notice.ObjectsChanged)
+
+def test_transaction_create_from_broker_with_path_predicate():
+    """Create a transaction and only capture changes under prefixes."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    predicate = unf.CapturePredicate.And(
+        unf.CapturePredicate.UnderPaths([Sdf.Path("/Foo")]),
+        unf.CapturePredicate.Not(
+            unf.CapturePredicate.BlockTypes([unf.Notice.ObjectsChanged])
+        ),
+    )
+
+    with unf.NoticeTransaction(broker, predicate=predicate):
+        stage.DefinePrim("/Foo")
+        stage.DefinePrim("/Bar")
+
+    # Ensure that only changes under '/Foo' were captured.
+    assert len(received) == 1
+    assert received[0].GetResyncedPaths() == ["/Foo"]
+
+def test_transaction_create_from_broker_with_per_type_predicate():
+    """Create a transaction with a predicate memoized per notice type."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    key1 = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+    key2 = Tf.Notice.Register(
+        unf.Notice.StageContentsChanged, _validate, stage
+    )
+
+    evaluated = []
+
+    def _predicate(notice):
+        """Only capture ObjectsChanged notices."""
+        evaluated.append(notice)
+        return isinstance(notice, unf.Notice.ObjectsChanged)
+
+    predicate = unf.CapturePredicate.PerType(_predicate)
+
+    with unf.NoticeTransaction(broker, predicate=predicate):
+        stage.DefinePrim("/Foo")
+        stage.DefinePrim("/Bar")
+
+    # Ensure that only ObjectsChanged notice was received.
+    assert len(received) == 1
+    assert isinstance(received[0], unf.Notice.ObjectsChanged)
+
+    # Ensure that function was only invoked once per notice type.
+    assert len(evaluated) == 2
+
+def test_transaction_create_from_broker_with_batched_predicate():
+    """Create a transaction with a predicate evaluated when it ends."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    evaluated = []
+
+    def _predicate(notice):
+        """Only capture changes under '/Foo'."""
+        evaluated.append(notice)
+        if not isinstance(notice, unf.Notice.ObjectsChanged):
+            return True
+
+        prefix = Sdf.Path("/Foo")
+        return all(
+            path.HasPrefix(prefix) for path in notice.GetResyncedPaths()
+        )
+
+    predicate = unf.CapturePredicate.Batched(_predicate)
+
+    with unf.NoticeTransaction(broker, predicate=predicate):
+        stage.DefinePrim("/Foo")
+        stage.DefinePrim("/Bar")
+        stage.DefinePrim("/Foo/Baz")
+
+        # Ensure that function is not invoked until the transaction ends.
+        assert len(evaluated) == 0
+
+    # Ensure that each notice was evaluated before being merged.
+    assert len(evaluated) == 6
+
+    assert len(received) == 1
+    assert received[0].GetResyncedPaths() == ["/Foo"]
+
+def test_transaction_create_from_broker_with_scope():
+    """Create a transaction from broker restricted to subtrees."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    with unf.NoticeTransaction(broker, [Sdf.Path("/Foo")]):
+        stage.DefinePrim("/Foo")
+        stage.DefinePrim("/Bar")
+
+    # Ensure that changes outside of the scope were trimmed.
+    assert len(received) == 1
+    assert received[0].GetResyncedPaths() == ["/Foo"]
+
+    with unf.NoticeTransaction(
+        broker, scope=[Sdf.Path("/Foo")], predicate=lambda n: True
+    ):
+        stage.DefinePrim("/Foo/Baz")
+        stage.DefinePrim("/Bar/Baz")
+
+    assert len(received) == 2
+    assert received[1].GetResyncedPaths() == ["/Foo/Baz"]
+
+
 def test_transaction_create_from_stage():
     """Create a transaction from stage."""
     stage = Usd.Stage.CreateInMemory()
@@ -146,6 +308,31 @@ def test_transaction_create_from_stage():
     # Ensure that one notice was received.
     assert len(received) == 1
 
+def test_transaction_create_from_stage_with_scope():
+    """Create a transaction from stage restricted to subtrees."""
+    stage = Usd.Stage.CreateInMemory()
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    with unf.NoticeTransaction(
+        stage,
+        scope=[Sdf.Path("/Foo")],
+        predicate=unf.CapturePredicate.Default(),
+    ):
+        stage.DefinePrim("/Foo")
+        stage.DefinePrim("/Bar")
+
+    # Ensure that changes outside of the scope were trimmed.
+    assert len(received) == 1
+    assert received[0].GetResyncedPaths() == ["/Foo"]
+
+
 def test_transaction_create_from_stage_with_filter():
     """Create a transaction from stage with filter."""
     stage = Usd.Stage.CreateInMemory()
@@ -3,6 +3,9 @@
 #include <gtest/gtest.h>
 #include <pxr/usd/usd/stage.h>
 
+#include <thread>
+#include <vector>
+
 TEST(BrokerTest, Create)
 {
     auto stage = PXR_NS::UsdStage::CreateInMemory();
@@ -37,6 +40,10 @@ TEST(BrokerTest, CreateMultiple)
 
 TEST(BrokerTest, CleanRegistry)
 {
+    // Start from an empty registry as expired stages are reclaimed in
+    // order of registration.
+    unf::Broker::ResetAll();
+
     auto stage1 = PXR_NS::UsdStage::CreateInMemory();
     auto broker1 = unf::Broker::Create(stage1);
     ASSERT_EQ(broker1->GetCurrentCount(), 2);
@@ -51,6 +58,83 @@ TEST(BrokerTest, CleanRegistry)
     ASSERT_EQ(broker1->GetCurrentCount(), 1);
 }
 
+TEST(BrokerTest, CleanRegistryIncrementally)
+{
+    unf::Broker::ResetAll();
+
+    std::vector<unf::BrokerPtr> brokers;
+    for (size_t i = 0; i < 10; ++i) {
+        auto stage = PXR_NS::UsdStage::CreateInMemory();
+        brokers.push_back(unf::Broker::Create(stage));
+    }
+
+    // Stages are destroyed, but broker references are kept in registry.
+    for (auto& broker : brokers) {
+        ASSERT_EQ(broker->GetCurrentCount(), 2);
+    }
+
+    // Each broker added reclaims more than one expired stage, so all
+    // registry references are removed before as many brokers are added.
+    std::vector<PXR_NS::UsdStageRefPtr> stages;
+    for (size_t i = 0; i < 10; ++i) {
+        stages.push_back(PXR_NS::UsdStage::CreateInMemory());
+        unf::Broker::Create(stages.back());
+    }
+
+    for (auto& broker : brokers) {
+        ASSERT_EQ(broker->GetCurrentCount(), 1);
+    }
+}
+
+TEST(BrokerTest, CleanRegistryAtOnce)
+{
+    unf::Broker::ResetAll();
+
+    std::vector<unf::BrokerPtr> brokers;
+    for (size_t i = 0; i < 10; ++i) {
+        auto stage = PXR_NS::UsdStage::CreateInMemory();
+        brokers.push_back(unf::Broker::Create(stage));
+    }
+
+    // Registry references are all removed when a single broker is added,
+    // as the oldest records are all expired.
+    auto stage = PXR_NS::UsdStage::CreateInMemory();
+    unf::Broker::Create(stage);
+
+    for (auto& broker : brokers) {
+        ASSERT_EQ(broker->GetCurrentCount(), 1);
+    }
+}
+
+TEST(BrokerTest, CleanRegistryBehindLiveStages)
+{
+    unf::Broker::ResetAll();
+
+    // Oldest records target stages which are kept alive.
+    std::vector<PXR_NS::UsdStageRefPtr> stages;
+    for (size_t i = 0; i < 10; ++i) {
+        stages.push_back(PXR_NS::UsdStage::CreateInMemory());
+        unf::Broker::Create(stages.back());
+    }
+
+    std::vector<unf::BrokerPtr> brokers;
+    for (size_t i = 0; i < 10; ++i) {
+        auto stage = PXR_NS::UsdStage::CreateInMemory();
+        brokers.push_back(unf::Broker::Create(stage));
+    }
+
+    // Live records are inspected a few at a time, and expired records
+    // following them are reclaimed at once.
+    for (size_t i = 0; i < 10; ++i) {
+        stages.push_back(PXR_NS::UsdStage::CreateInMemory());
+        unf::Broker::Create(stages.back());
+    }
+
+    for (auto& broker : brokers) {
+        ASSERT_EQ(broker->GetCurrentCount(), 1);
+    }
+}
+
 TEST(BrokerTest, Reset)
 {
     auto stage = PXR_NS::UsdStage::CreateInMemory();
@@ -82,3 +166,51 @@ TEST(BrokerTest, ResetAll)
     ASSERT_EQ(broker2->GetCurrentCount(), 1);
     ASSERT_EQ(broker3->GetCurrentCount(), 1);
 }
+
+TEST(BrokerTest, CreateConcurrently)
+{
+    const size_t threadCount = 16;
+    const size_t iterations = 100;
+
+    std::vector<PXR_NS::UsdStageRefPtr> stages;
+    for (size_t index = 0; index < 8; ++index) {
+        stages.push_back(PXR_NS::UsdStage::CreateInMemory());
+    }
+
+    std::vector<std::vector<unf::BrokerPtr> > results(threadCount);
+    std::vector<std::thread> threads;
+
+    for (size_t thread = 0; thread < threadCount; ++thread) {
+        threads.emplace_back([&, thread]() {
+            for (size_t index = 0; index < iterations; ++index) {
+                // Retrieve brokers for stages shared between threads.
+                const auto& stage = stages[(thread + index) % stages.size()];
+                results[thread].push_back(unf::Broker::Create(stage));
+
+                // Create and release brokers for stages local to thread.
+                auto localStage = PXR_NS::UsdStage::CreateInMemory();
+                auto broker = unf::Broker::Create(localStage);
+                if (index % 2 == 0) {
+                    broker->Reset();
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Only one broker was created for each shared stage.
+    for (size_t thread = 0; thread < threadCount; ++thread) {
+        ASSERT_EQ(results[thread].size(), iterations);
+
+        for (size_t index = 0; index < iterations; ++index) {
+            const auto& stage = stages[(thread + index) % stages.size()];
+            ASSERT_EQ(results[thread][index], unf::Broker::Create(stage));
+            ASSERT_EQ(results[thread][index]->GetStage(), stage);
+        }
+    }
+
+    unf::Broker::ResetAll();
+}
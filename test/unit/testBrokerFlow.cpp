@@ -1,13 +1,26 @@
 #include <unf/broker.h>
 #include <unf/capturePredicate.h>
+#include <unf/notice.h>
 
 #include <unfTest/listener.h>
 #include <unfTest/notice.h>
 #include <unfTest/observer.h>
 
 #include <gtest/gtest.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/types.h>
+#include <pxr/usd/usd/attribute.h>
+#include <pxr/usd/usd/prim.h>
 #include <pxr/usd/usd/stage.h>
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
 class BrokerFlowTest : public ::testing::Test {
   protected:
     using Listener =
@@ -19,6 +32,44 @@ class BrokerFlowTest : public ::testing::Test {
         _listener.SetStage(_stage);
     }
 
+    // Edit a new stage within a nested transaction joined into an enclosing
+    // transaction, where an attribute is modified before its prim is
+    // resynced, and return the ObjectsChanged notice received. Broker is
+    // set up with \p configure before the transactions start.
+    static unf::UnfNotice::ObjectsChanged _EditNested(
+        const std::function<void(const unf::BrokerPtr&)>& configure)
+    {
+        auto stage = PXR_NS::UsdStage::CreateInMemory();
+        auto prim1 = stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+        auto prim2 = stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+        auto prim3 = stage->DefinePrim(PXR_NS::SdfPath{"/Baz"});
+        prim1.CreateAttribute(
+            PXR_NS::TfToken{"test"}, PXR_NS::SdfValueTypeNames->Double);
+
+        auto broker = unf::Broker::Create(stage);
+        configure(broker);
+
+        ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(stage);
+
+        broker->BeginTransaction();
+        prim2.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+
+        // Nested transaction with a distinct predicate is joined into the
+        // enclosing transaction when it ends.
+        broker->BeginTransaction(
+            [](const unf::UnfNotice::StageNotice&) { return true; });
+
+        prim1.GetAttribute(PXR_NS::TfToken{"test"}).Set(5.0);
+        prim3.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+        prim1.SetTypeName(PXR_NS::TfToken{"Xform"});
+
+        broker->EndTransaction();
+        broker->EndTransaction();
+
+        EXPECT_EQ(observer.Received(), 1);
+        return observer.GetLatestNotice();
+    }
+
     PXR_NS::UsdStageRefPtr _stage;
     Listener _listener;
 };
@@ -112,6 +163,132 @@ TEST_F(BrokerFlowTest, NestedTransaction)
     ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 6);
 }
 
+TEST_F(BrokerFlowTest, NestedTransactionWithIdenticalPredicate)
+{
+    auto broker = unf::Broker::Create(_stage);
+    auto predicate = unf::CapturePredicate::BlockAll();
+
+    broker->BeginTransaction(predicate);
+
+    broker->Send<::Test::MergeableNotice>();
+
+    broker->BeginTransaction(predicate);
+    broker->BeginTransaction(predicate);
+
+    broker->Send<::Test::MergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+
+    broker->EndTransaction();
+    broker->EndTransaction();
+    ASSERT_TRUE(broker->IsInTransaction());
+
+    broker->EndTransaction();
+    ASSERT_FALSE(broker->IsInTransaction());
+
+    // Notices are not captured by nested transactions.
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 0);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 0);
+}
+
+TEST_F(BrokerFlowTest, NestedTransactionWithDefaultPredicate)
+{
+    auto broker = unf::Broker::Create(_stage);
+
+    ::Test::Observer<::Test::MergeableNotice> observer(_stage);
+
+    broker->BeginTransaction(
+        unf::CapturePredicate::AllowTypes<::Test::MergeableNotice>());
+
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Foo", "Test1"}}));
+
+    broker->BeginTransaction();
+    broker->BeginTransaction();
+
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Bar", "Test2"}}));
+    broker->Send<::Test::UnMergeableNotice>();
+
+    broker->EndTransaction();
+    broker->EndTransaction();
+    ASSERT_TRUE(broker->IsInTransaction());
+
+    broker->EndTransaction();
+    ASSERT_FALSE(broker->IsInTransaction());
+
+    // Nested transactions capture notices as the enclosing transaction.
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 0);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(
+        n.GetData(), ::Test::DataMap({{"Foo", "Test1"}, {"Bar", "Test2"}}));
+}
+
+TEST_F(BrokerFlowTest, NestedTransactionWithDistinctPredicate)
+{
+    auto broker = unf::Broker::Create(_stage);
+
+    // Filter out UnMergeableNotice type.
+    std::string target = typeid(::Test::UnMergeableNotice).name();
+    auto predicate = [&](const unf::UnfNotice::StageNotice& n) {
+        return (typeid(n).name() != target);
+    };
+
+    broker->BeginTransaction();
+
+    broker->Send<::Test::MergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+
+    broker->BeginTransaction(predicate);
+
+    broker->Send<::Test::MergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+
+    broker->BeginTransaction();
+
+    broker->Send<::Test::UnMergeableNotice>();
+
+    broker->EndTransaction();
+    broker->EndTransaction();
+    ASSERT_TRUE(broker->IsInTransaction());
+
+    broker->EndTransaction();
+    ASSERT_FALSE(broker->IsInTransaction());
+
+    // Nested predicates apply to transactions nested within their scope.
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 1);
+}
+
+TEST_F(BrokerFlowTest, NestedTransactionWithEnclosingPredicate)
+{
+    auto broker = unf::Broker::Create(_stage);
+
+    size_t count = 0;
+    auto predicate = [&](const unf::UnfNotice::StageNotice&) {
+        count++;
+        return true;
+    };
+
+    broker->BeginTransaction(
+        unf::CapturePredicate::AllowTypes<::Test::MergeableNotice>());
+
+    broker->BeginTransaction(predicate);
+
+    broker->Send<::Test::MergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+
+    // Notices rejected by the enclosing transaction are discarded before
+    // the nested predicate is evaluated.
+    ASSERT_EQ(count, 1);
+
+    broker->EndTransaction();
+    broker->EndTransaction();
+
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 0);
+}
+
 TEST_F(BrokerFlowTest, MergeableNotice)
 {
     auto broker = unf::Broker::Create(_stage);
@@ -138,6 +315,138 @@ TEST_F(BrokerFlowTest, MergeableNotice)
         n.GetData(), ::Test::DataMap({{"Foo", "Test2"}, {"Bar", "Test3"}}));
 }
 
+TEST_F(BrokerFlowTest, ParallelMerge)
+{
+    auto broker = unf::Broker::Create(_stage);
+    ASSERT_EQ(broker->GetParallelThreshold(), 0);
+
+    broker->SetParallelThreshold(2);
+    ASSERT_EQ(broker->GetParallelThreshold(), 2);
+
+    ::Test::Observer<::Test::MergeableNotice> observer(_stage);
+
+    broker->BeginTransaction();
+
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Foo", "Test1"}}));
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Foo", "Test2"}}));
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Bar", "Test3"}}));
+
+    broker->Send<::Test::UnMergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+
+    broker->EndTransaction();
+
+    // Result is identical to a sequential merge.
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 3);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(
+        n.GetData(), ::Test::DataMap({{"Foo", "Test2"}, {"Bar", "Test3"}}));
+}
+
+TEST_F(BrokerFlowTest, TransactionBudget)
+{
+    auto broker = unf::Broker::Create(_stage);
+    ASSERT_EQ(broker->GetTransactionBudget(), 0);
+
+    broker->SetTransactionBudget(2);
+    ASSERT_EQ(broker->GetTransactionBudget(), 2);
+
+    ::Test::Observer<::Test::MergeableNotice> observer(_stage);
+
+    broker->BeginTransaction();
+
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Foo", "Test1"}}));
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Foo", "Test2"}}));
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Bar", "Test3"}}));
+
+    broker->Send<::Test::UnMergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Bar", "Test4"}}));
+
+    broker->EndTransaction();
+
+    // Result is identical to a merge at the end of the transaction.
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 3);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(
+        n.GetData(), ::Test::DataMap({{"Foo", "Test2"}, {"Bar", "Test4"}}));
+}
+
+TEST_F(BrokerFlowTest, NestedTransactionBudgetWithObjectsChanged)
+{
+    auto n1 = _EditNested([](const unf::BrokerPtr&) {});
+    auto n2 = _EditNested([](const unf::BrokerPtr& broker) {
+        broker->SetTransactionBudget(3);
+    });
+
+    // Attribute modified before its prim is resynced is kept.
+    const auto& paths = n2.GetChangedInfoOnlyPaths();
+    ASSERT_NE(
+        std::find(paths.begin(), paths.end(), PXR_NS::SdfPath{"/Foo.test"}),
+        paths.end());
+
+    // Result is identical to a merge at the end of the transaction.
+    ASSERT_EQ(n1.GetResyncedPaths(), n2.GetResyncedPaths());
+    ASSERT_EQ(n1.GetChangedInfoOnlyPaths(), n2.GetChangedInfoOnlyPaths());
+    ASSERT_EQ(n1.GetChangedFieldMap(), n2.GetChangedFieldMap());
+}
+
+TEST_F(BrokerFlowTest, SendOrder)
+{
+    auto broker = unf::Broker::Create(_stage);
+
+    broker->BeginTransaction();
+
+    broker->Send<::Test::UnMergeableNotice>();
+    broker->Send<::Test::MergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+    broker->Send<::Test::MergeableNotice>();
+
+    broker->EndTransaction();
+
+    // Notice types are sent in the order they were first captured.
+    std::string mergeable = typeid(::Test::MergeableNotice).name();
+    std::string unmergeable = typeid(::Test::UnMergeableNotice).name();
+
+    ASSERT_EQ(
+        _listener.History(),
+        std::vector<std::string>({unmergeable, unmergeable, mergeable}));
+}
+
+TEST_F(BrokerFlowTest, SendOrderWithPriority)
+{
+    auto broker = unf::Broker::Create(_stage);
+    ASSERT_EQ(broker->GetPriority<::Test::MergeableNotice>(), 0);
+
+    broker->SetPriority<::Test::MergeableNotice>(1);
+    ASSERT_EQ(broker->GetPriority<::Test::MergeableNotice>(), 1);
+    ASSERT_EQ(broker->GetPriority<::Test::UnMergeableNotice>(), 0);
+
+    broker->BeginTransaction();
+
+    broker->Send<::Test::UnMergeableNotice>();
+    broker->Send<::Test::MergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+    broker->Send<::Test::MergeableNotice>();
+
+    broker->EndTransaction();
+
+    // Notice types with higher priority are sent first.
+    std::string mergeable = typeid(::Test::MergeableNotice).name();
+    std::string unmergeable = typeid(::Test::UnMergeableNotice).name();
+
+    ASSERT_EQ(
+        _listener.History(),
+        std::vector<std::string>({mergeable, unmergeable, unmergeable}));
+}
+
 TEST_F(BrokerFlowTest, WithFilter)
 {
     auto broker = unf::Broker::Create(_stage);
@@ -230,3 +539,484 @@ TEST_F(BrokerFlowTest, WithBlockAllPredicate)
     ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 0);
     ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 0);
 }
+
+TEST_F(BrokerFlowTest, StreamingMerge)
+{
+    auto broker = unf::Broker::Create(_stage);
+    ASSERT_FALSE(broker->IsStreamingMerge());
+
+    broker->SetStreamingMerge(true);
+    ASSERT_TRUE(broker->IsStreamingMerge());
+
+    ::Test::Observer<::Test::MergeableNotice> observer(_stage);
+
+    broker->BeginTransaction();
+
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Foo", "Test1"}}));
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Foo", "Test2"}}));
+
+    broker->BeginTransaction();
+
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Bar", "Test3"}}));
+
+    broker->Send<::Test::UnMergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+
+    broker->EndTransaction();
+
+    // No notices are emitted while at least one transaction is started.
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 0);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 0);
+
+    broker->EndTransaction();
+
+    // Result is identical to a deferred merge.
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 3);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(
+        n.GetData(), ::Test::DataMap({{"Foo", "Test2"}, {"Bar", "Test3"}}));
+}
+
+TEST_F(BrokerFlowTest, NestedStreamingMergeWithObjectsChanged)
+{
+    auto n1 = _EditNested([](const unf::BrokerPtr&) {});
+    auto n2 = _EditNested(
+        [](const unf::BrokerPtr& broker) { broker->SetStreamingMerge(true); });
+
+    // Attribute modified before its prim is resynced is kept.
+    const auto& paths = n2.GetChangedInfoOnlyPaths();
+    ASSERT_NE(
+        std::find(paths.begin(), paths.end(), PXR_NS::SdfPath{"/Foo.test"}),
+        paths.end());
+
+    // Result is identical to a deferred merge.
+    ASSERT_EQ(n1.GetResyncedPaths(), n2.GetResyncedPaths());
+    ASSERT_EQ(n1.GetChangedInfoOnlyPaths(), n2.GetChangedInfoOnlyPaths());
+    ASSERT_EQ(n1.GetChangedFieldMap(), n2.GetChangedFieldMap());
+}
+
+TEST_F(BrokerFlowTest, BatchedPredicate)
+{
+    // Evaluator rejecting mergeable notices holding a 'Reject' key, which
+    // records the number of batches evaluated.
+    class Evaluator : public unf::CapturePredicate::Evaluator {
+      public:
+        explicit Evaluator(size_t& batches) : _batches(batches) {}
+
+        bool operator()(const unf::UnfNotice::StageNotice& n) const override
+        {
+            auto notice = dynamic_cast<const ::Test::MergeableNotice*>(&n);
+            return !notice || notice->GetData().count("Reject") == 0;
+        }
+
+        void Evaluate(
+            const std::vector<unf::UnfNotice::StageNoticeRefPtr>& notices,
+            std::vector<bool>& results) const override
+        {
+            _batches++;
+            unf::CapturePredicate::Evaluator::Evaluate(notices, results);
+        }
+
+        bool IsBatched() const override { return true; }
+
+      private:
+        size_t& _batches;
+    };
+
+    auto broker = unf::Broker::Create(_stage);
+    broker->SetStreamingMerge(true);
+
+    ::Test::Observer<::Test::MergeableNotice> observer(_stage);
+
+    size_t batches = 0;
+    auto predicate =
+        unf::CapturePredicate(std::make_shared<const Evaluator>(batches));
+    ASSERT_TRUE(predicate.IsBatched());
+
+    broker->BeginTransaction(predicate);
+
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Foo", "Test1"}}));
+    broker->Send<::Test::MergeableNotice>(
+        ::Test::DataMap({{"Reject", "Test2"}}));
+    broker->Send<::Test::UnMergeableNotice>();
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Bar", "Test3"}}));
+
+    // Predicate is not evaluated until the transaction ends.
+    ASSERT_EQ(batches, 0);
+
+    broker->EndTransaction();
+
+    // All notices are evaluated within a single batch, before being merged.
+    ASSERT_EQ(batches, 1);
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(
+        n.GetData(), ::Test::DataMap({{"Foo", "Test1"}, {"Bar", "Test3"}}));
+}
+
+TEST_F(BrokerFlowTest, NestedTransactionWithBatchedPredicate)
+{
+    // Evaluator rejecting mergeable notices holding a 'Reject' key.
+    class Evaluator : public unf::CapturePredicate::Evaluator {
+      public:
+        bool operator()(const unf::UnfNotice::StageNotice& n) const override
+        {
+            auto notice = dynamic_cast<const ::Test::MergeableNotice*>(&n);
+            return !notice || notice->GetData().count("Reject") == 0;
+        }
+
+        bool IsBatched() const override { return true; }
+    };
+
+    auto broker = unf::Broker::Create(_stage);
+    broker->SetStreamingMerge(true);
+    broker->SetTransactionBudget(2);
+
+    ::Test::Observer<::Test::MergeableNotice> observer(_stage);
+
+    broker->BeginTransaction(
+        unf::CapturePredicate(std::make_shared<const Evaluator>()));
+
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Foo", "Test1"}}));
+
+    broker->BeginTransaction(
+        [](const unf::UnfNotice::StageNotice&) { return true; });
+
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Bar", "Test2"}}));
+    broker->Send<::Test::MergeableNotice>(
+        ::Test::DataMap({{"Reject", "Test3"}}));
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Baz", "Test4"}}));
+
+    broker->EndTransaction();
+    broker->EndTransaction();
+
+    // Notices captured by the nested transaction are not merged before the
+    // batched predicate of the enclosing transaction is evaluated.
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(
+        n.GetData(),
+        ::Test::DataMap({{"Foo", "Test1"}, {"Bar", "Test2"}, {"Baz", "Test4"}}));
+}
+
+TEST_F(BrokerFlowTest, ThreadLocalTransactions)
+{
+    auto broker = unf::Broker::Create(_stage);
+    ASSERT_FALSE(broker->IsThreadLocalTransactions());
+
+    broker->SetThreadLocalTransactions(true);
+    ASSERT_TRUE(broker->IsThreadLocalTransactions());
+
+    ::Test::Observer<::Test::MergeableNotice> observer(_stage);
+
+    broker->BeginTransaction();
+
+    std::vector<std::thread> threads;
+    for (size_t index = 0; index < 8; ++index) {
+        threads.emplace_back([&, index]() {
+            const auto suffix = std::to_string(index);
+
+            // Notices sent without transaction on this thread.
+            broker->Send<::Test::MergeableNotice>(
+                ::Test::DataMap({{"Foo" + suffix, "Test"}}));
+            broker->Send<::Test::UnMergeableNotice>();
+
+            // Notices sent within a transaction local to this thread.
+            broker->BeginTransaction();
+            broker->Send<::Test::MergeableNotice>(
+                ::Test::DataMap({{"Bar" + suffix, "Test"}}));
+            broker->Send<::Test::UnMergeableNotice>();
+            broker->EndTransaction();
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // No notices are emitted while a transaction is started on any thread.
+    ASSERT_TRUE(broker->IsInTransaction());
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 0);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 0);
+
+    broker->EndTransaction();
+    ASSERT_FALSE(broker->IsInTransaction());
+
+    // Notices captured from all threads are consolidated.
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 16);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(n.GetData().size(), 16);
+}
+
+TEST_F(BrokerFlowTest, ThreadLocalTransactionsWithPredicate)
+{
+    auto broker = unf::Broker::Create(_stage);
+    broker->SetThreadLocalTransactions(true);
+
+    broker->BeginTransaction(
+        unf::CapturePredicate::AllowTypes<::Test::MergeableNotice>());
+
+    std::vector<std::thread> threads;
+    for (size_t index = 0; index < 8; ++index) {
+        threads.emplace_back([&]() {
+            // Notices sent without transaction on this thread.
+            broker->Send<::Test::MergeableNotice>();
+            broker->Send<::Test::UnMergeableNotice>();
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    broker->EndTransaction();
+
+    // Notices sent from other threads are rejected by the predicate of the
+    // transaction started.
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 0);
+
+    // Notices are sent immediately once the transaction is closed.
+    broker->Send<::Test::UnMergeableNotice>();
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 1);
+}
+
+TEST_F(BrokerFlowTest, AsyncDelivery)
+{
+    auto broker = unf::Broker::Create(_stage);
+    ASSERT_FALSE(broker->GetExecutor());
+
+    auto executor = unf::ThreadExecutor::Create();
+    broker->SetExecutor(executor);
+    ASSERT_EQ(broker->GetExecutor(), executor);
+
+    ::Test::Observer<::Test::MergeableNotice> observer(_stage);
+
+    broker->BeginTransaction();
+
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Foo", "Test1"}}));
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Bar", "Test2"}}));
+
+    broker->Send<::Test::UnMergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+
+    broker->EndTransaction();
+
+    // Notices sent outside of transaction are delivered after.
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Baz", "Test3"}}));
+
+    broker->WaitForDelivery();
+
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 2);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 2);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(n.GetData(), ::Test::DataMap({{"Baz", "Test3"}}));
+
+    // Restore synchronous delivery.
+    broker->SetExecutor(nullptr);
+    ASSERT_FALSE(broker->GetExecutor());
+
+    broker->Send<::Test::UnMergeableNotice>();
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 3);
+}
+
+TEST_F(BrokerFlowTest, AutoBatching)
+{
+    auto broker = unf::Broker::Create(_stage);
+    ASSERT_FALSE(broker->IsAutoBatching());
+
+    broker->SetAutoBatching(true);
+    ASSERT_TRUE(broker->IsAutoBatching());
+    ASSERT_FALSE(broker->IsInTransaction());
+
+    broker->Send<::Test::MergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+
+    // Notices captured by transactions are added to the batch.
+    broker->BeginTransaction();
+    broker->Send<::Test::MergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+    broker->EndTransaction();
+
+    // No notices are emitted until next tick.
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 0);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 0);
+
+    broker->Tick();
+
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 2);
+
+    // Nothing is emitted when batch is empty.
+    broker->Tick();
+
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 2);
+}
+
+TEST_F(BrokerFlowTest, AutoBatchingDisabled)
+{
+    auto broker = unf::Broker::Create(_stage);
+    broker->SetAutoBatching(true);
+
+    broker->Send<::Test::MergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 0);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 0);
+
+    // Disabling auto-batching emits notices batched.
+    broker->SetAutoBatching(false);
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 1);
+
+    // Notices are then emitted immediately.
+    broker->Send<::Test::UnMergeableNotice>();
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 2);
+}
+
+TEST_F(BrokerFlowTest, AutoBatchingDestroyed)
+{
+    auto broker = unf::Broker::Create(_stage);
+    broker->SetAutoBatching(true);
+
+    broker->Send<::Test::MergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 0);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 0);
+
+    // Destroying the broker emits notices batched.
+    broker->Reset();
+    broker.Reset();
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 1);
+}
+
+TEST_F(BrokerFlowTest, AutoBatchingWithThreshold)
+{
+    auto broker = unf::Broker::Create(_stage);
+    ASSERT_EQ(broker->GetAutoBatchThreshold(), 0);
+
+    broker->SetAutoBatching(true);
+    broker->SetAutoBatchThreshold(3);
+    ASSERT_EQ(broker->GetAutoBatchThreshold(), 3);
+
+    broker->Send<::Test::UnMergeableNotice>();
+    broker->Send<::Test::UnMergeableNotice>();
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 0);
+
+    // Batch is emitted when threshold is reached.
+    broker->Send<::Test::UnMergeableNotice>();
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 3);
+}
+
+TEST_F(BrokerFlowTest, AutoBatchingWithInterval)
+{
+    auto broker = unf::Broker::Create(_stage);
+    ASSERT_EQ(broker->GetAutoBatchInterval(), 0.0);
+
+    broker->SetAutoBatching(true);
+    broker->SetAutoBatchInterval(0.05);
+    ASSERT_EQ(broker->GetAutoBatchInterval(), 0.05);
+
+    broker->Send<::Test::UnMergeableNotice>();
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // Batch is emitted when a notice is added after interval elapsed.
+    broker->Send<::Test::UnMergeableNotice>();
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 2);
+}
+
+TEST_F(BrokerFlowTest, AutoBatchingWithIntervalAfterEmptyTransaction)
+{
+    auto broker = unf::Broker::Create(_stage);
+    broker->SetAutoBatching(true);
+    broker->SetAutoBatchInterval(0.05);
+
+    // Transaction without notices does not start the interval.
+    broker->BeginTransaction();
+    broker->EndTransaction();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    broker->Send<::Test::UnMergeableNotice>();
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // Interval is measured from the first notice batched.
+    broker->Send<::Test::UnMergeableNotice>();
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 2);
+}
+
+TEST_F(BrokerFlowTest, Subscribe)
+{
+    auto broker = unf::Broker::Create(_stage);
+
+    std::vector<::Test::DataMap> received;
+    auto subscription = broker->Subscribe<::Test::MergeableNotice>(
+        [&](const ::Test::MergeableNotice& notice) {
+            received.push_back(notice.GetData());
+        });
+    ASSERT_TRUE(subscription.IsValid());
+
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Foo", "Test1"}}));
+    broker->Send<::Test::UnMergeableNotice>();
+
+    broker->BeginTransaction();
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Bar", "Test2"}}));
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Baz", "Test3"}}));
+    broker->EndTransaction();
+
+    // Subscribed callback only receives notices of its type.
+    ASSERT_EQ(
+        received,
+        std::vector<::Test::DataMap>(
+            {::Test::DataMap({{"Foo", "Test1"}}),
+             ::Test::DataMap({{"Bar", "Test2"}, {"Baz", "Test3"}})}));
+
+    // Notices are still sent as TfNotice.
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 2);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 1);
+
+    // Callback is unsubscribed when handle is reset.
+    subscription.Reset();
+    ASSERT_FALSE(subscription.IsValid());
+
+    broker->Send<::Test::MergeableNotice>(::Test::DataMap({{"Foo", "Test4"}}));
+    ASSERT_EQ(received.size(), 2);
+}
+
+TEST_F(BrokerFlowTest, SubscribeWithoutTfNotice)
+{
+    auto broker = unf::Broker::Create(_stage);
+    ASSERT_TRUE(broker->IsTfNoticeDelivery());
+
+    broker->SetTfNoticeDelivery(false);
+    ASSERT_FALSE(broker->IsTfNoticeDelivery());
+
+    size_t received = 0;
+    {
+        auto subscription = broker->Subscribe<::Test::UnMergeableNotice>(
+            [&](const ::Test::UnMergeableNotice&) { received++; });
+
+        broker->Send<::Test::UnMergeableNotice>();
+        broker->Send<::Test::UnMergeableNotice>();
+    }
+
+    // Callback is unsubscribed when handle is destroyed.
+    broker->Send<::Test::UnMergeableNotice>();
+
+    ASSERT_EQ(received, 2);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 0);
+}
@@ -0,0 +1,249 @@
+#include <unf/broker.h>
+#include <unf/capturePredicate.h>
+#include <unf/notice.h>
+
+#include <unfTest/notice.h>
+#include <unfTest/observer.h>
+
+#include <gtest/gtest.h>
+#include <pxr/base/tf/type.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <memory>
+#include <vector>
+
+TEST(CapturePredicateTest, AllowTypes)
+{
+    auto predicate =
+        unf::CapturePredicate::AllowTypes<::Test::MergeableNotice>();
+
+    ASSERT_TRUE(predicate(*::Test::MergeableNotice::Create()));
+    ASSERT_FALSE(predicate(*::Test::UnMergeableNotice::Create()));
+}
+
+TEST(CapturePredicateTest, AllowTypesFromTfType)
+{
+    auto predicate = unf::CapturePredicate::AllowTypes(
+        {PXR_NS::TfType::Find<::Test::UnMergeableNotice>()});
+
+    ASSERT_FALSE(predicate(*::Test::MergeableNotice::Create()));
+    ASSERT_TRUE(predicate(*::Test::UnMergeableNotice::Create()));
+}
+
+TEST(CapturePredicateTest, BlockTypes)
+{
+    auto predicate =
+        unf::CapturePredicate::BlockTypes<::Test::MergeableNotice>();
+
+    ASSERT_FALSE(predicate(*::Test::MergeableNotice::Create()));
+    ASSERT_TRUE(predicate(*::Test::UnMergeableNotice::Create()));
+}
+
+TEST(CapturePredicateTest, Composition)
+{
+    using Predicate = unf::CapturePredicate;
+
+    auto mergeable = Predicate::AllowTypes<::Test::MergeableNotice>();
+    auto unmergeable = Predicate::AllowTypes<::Test::UnMergeableNotice>();
+
+    auto n1 = ::Test::MergeableNotice::Create();
+    auto n2 = ::Test::UnMergeableNotice::Create();
+
+    ASSERT_FALSE(Predicate::And(mergeable, unmergeable)(*n1));
+    ASSERT_TRUE(Predicate::Or(mergeable, unmergeable)(*n1));
+    ASSERT_TRUE(Predicate::Or(mergeable, unmergeable)(*n2));
+    ASSERT_FALSE(Predicate::Not(mergeable)(*n1));
+    ASSERT_TRUE(Predicate::Not(mergeable)(*n2));
+
+    // Default predicate is not evaluated in compositions.
+    ASSERT_EQ(Predicate::And(Predicate::Default(), mergeable), mergeable);
+    ASSERT_EQ(Predicate::And(mergeable, Predicate::Default()), mergeable);
+    ASSERT_TRUE(Predicate::Or(Predicate::Default(), mergeable).IsDefault());
+}
+
+TEST(CapturePredicateTest, ShortCircuit)
+{
+    using Predicate = unf::CapturePredicate;
+
+    size_t count = 0;
+    auto counter = Predicate([&](const unf::UnfNotice::StageNotice&) {
+        count++;
+        return true;
+    });
+
+    auto notice = ::Test::MergeableNotice::Create();
+
+    Predicate::And(Predicate::BlockAll(), counter)(*notice);
+    Predicate::Or(Predicate::Not(Predicate::BlockAll()), counter)(*notice);
+    ASSERT_EQ(count, 0);
+
+    Predicate::And(counter, Predicate::BlockAll())(*notice);
+    ASSERT_EQ(count, 1);
+}
+
+TEST(CapturePredicateTest, UnderPaths)
+{
+    auto stage = PXR_NS::UsdStage::CreateInMemory();
+    auto broker = unf::Broker::Create(stage);
+
+    stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(stage);
+
+    auto predicate =
+        unf::CapturePredicate::UnderPaths({PXR_NS::SdfPath{"/Foo"}});
+
+    // Other notice types are not filtered.
+    ASSERT_TRUE(predicate(*::Test::MergeableNotice::Create()));
+
+    stage->DefinePrim(PXR_NS::SdfPath{"/Foo/Child"});
+    ASSERT_TRUE(predicate(observer.GetLatestNotice()));
+
+    stage->DefinePrim(PXR_NS::SdfPath{"/Bar/Child"});
+    ASSERT_FALSE(predicate(observer.GetLatestNotice()));
+
+    stage->RemovePrim(PXR_NS::SdfPath{"/Foo"});
+    ASSERT_TRUE(predicate(observer.GetLatestNotice()));
+
+    stage->GetPrimAtPath(PXR_NS::SdfPath{"/Bar"})
+        .SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    ASSERT_FALSE(predicate(observer.GetLatestNotice()));
+}
+
+TEST(CapturePredicateTest, UnderPathsWithReferencedNotice)
+{
+    auto stage = PXR_NS::UsdStage::CreateInMemory();
+    auto broker = unf::Broker::Create(stage);
+
+    stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+
+    auto predicate =
+        unf::CapturePredicate::UnderPaths({PXR_NS::SdfPath{"/Foo"}});
+
+    // Evaluate notices while they reference data from the notice they were
+    // created from.
+    std::vector<bool> results;
+    auto subscription = broker->Subscribe<unf::UnfNotice::ObjectsChanged>(
+        [&](const unf::UnfNotice::ObjectsChanged& notice) {
+            results.push_back(predicate(notice));
+        });
+
+    stage->DefinePrim(PXR_NS::SdfPath{"/Foo/Child"});
+    stage->DefinePrim(PXR_NS::SdfPath{"/Bar/Child"});
+    stage->GetPrimAtPath(PXR_NS::SdfPath{"/Foo"})
+        .SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+
+    ASSERT_EQ(results, std::vector<bool>({true, false, true}));
+}
+
+TEST(CapturePredicateTest, PerType)
+{
+    size_t count = 0;
+    auto predicate = unf::CapturePredicate::PerType(
+        [&](const unf::UnfNotice::StageNotice& notice) {
+            count++;
+            return notice.GetTypeIndex() ==
+                   ::Test::MergeableNotice::GetStaticTypeIndex();
+        });
+
+    ASSERT_TRUE(predicate(*::Test::MergeableNotice::Create()));
+    ASSERT_FALSE(predicate(*::Test::UnMergeableNotice::Create()));
+    ASSERT_EQ(count, 2);
+
+    // Function is only invoked once per notice type.
+    ASSERT_TRUE(predicate(*::Test::MergeableNotice::Create()));
+    ASSERT_FALSE(predicate(*::Test::UnMergeableNotice::Create()));
+    ASSERT_EQ(count, 2);
+}
+
+TEST(CapturePredicateTest, Filter)
+{
+    auto predicate =
+        unf::CapturePredicate::AllowTypes<::Test::MergeableNotice>();
+
+    auto n1 = ::Test::MergeableNotice::Create();
+    auto n2 = ::Test::UnMergeableNotice::Create();
+    auto n3 = ::Test::MergeableNotice::Create();
+
+    std::vector<unf::UnfNotice::StageNoticeRefPtr> notices{n1, n2, n3};
+    predicate.Filter(notices);
+
+    // Order of notices kept is preserved.
+    ASSERT_EQ(notices.size(), 2);
+    ASSERT_EQ(notices[0], n1);
+    ASSERT_EQ(notices[1], n3);
+}
+
+TEST(CapturePredicateTest, FilterWithBatchedComposition)
+{
+    // Batched evaluator recording the number of notices per batch.
+    class _Evaluator : public unf::CapturePredicate::Evaluator {
+      public:
+        explicit _Evaluator(std::vector<size_t>& batches) : _batches(batches)
+        {
+        }
+
+        bool operator()(const unf::UnfNotice::StageNotice&) const override
+        {
+            _batches.push_back(1);
+            return true;
+        }
+
+        void Evaluate(
+            const std::vector<unf::UnfNotice::StageNoticeRefPtr>& notices,
+            std::vector<bool>& results) const override
+        {
+            _batches.push_back(notices.size());
+            results.assign(notices.size(), true);
+        }
+
+        bool IsBatched() const override { return true; }
+
+      private:
+        std::vector<size_t>& _batches;
+    };
+
+    using Predicate = unf::CapturePredicate;
+
+    std::vector<size_t> batches;
+    auto batched = Predicate(std::make_shared<const _Evaluator>(batches));
+    auto typed = Predicate::AllowTypes<::Test::MergeableNotice>();
+
+    ASSERT_TRUE(Predicate::And(batched, typed).IsBatched());
+    ASSERT_TRUE(Predicate::Or(typed, batched).IsBatched());
+    ASSERT_TRUE(Predicate::Not(batched).IsBatched());
+    ASSERT_FALSE(Predicate::And(typed, Predicate::BlockAll()).IsBatched());
+
+    auto n1 = ::Test::MergeableNotice::Create();
+    auto n2 = ::Test::UnMergeableNotice::Create();
+    auto n3 = ::Test::MergeableNotice::Create();
+
+    std::vector<unf::UnfNotice::StageNoticeRefPtr> notices{n1, n2, n3};
+    Predicate::And(batched, typed).Filter(notices);
+
+    ASSERT_EQ(notices.size(), 2);
+    ASSERT_EQ(notices[0], n1);
+    ASSERT_EQ(notices[1], n3);
+
+    // All notices are evaluated by the batched predicate at once.
+    ASSERT_EQ(batches, std::vector<size_t>{3});
+
+    // Batched predicate is only evaluated for notices which are not decided
+    // by the first predicate.
+    batches.clear();
+    notices = {n1, n2, n3};
+    Predicate::And(typed, batched).Filter(notices);
+
+    ASSERT_EQ(notices.size(), 2);
+    ASSERT_EQ(batches, std::vector<size_t>{2});
+
+    batches.clear();
+    notices = {n1, n2, n3};
+    Predicate::Not(batched).Filter(notices);
+
+    ASSERT_TRUE(notices.empty());
+    ASSERT_EQ(batches, std::vector<size_t>{3});
+}
@@ -0,0 +1,184 @@
+#include <unf/changedFieldTable.h>
+
+#include <gtest/gtest.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/usd/sdf/path.h>
+
+#include <string>
+#include <utility>
+
+using ChangedFieldMap = unf::ChangedFieldMap;
+using TfTokenSet = unf::TfTokenSet;
+
+TEST(ChangedFieldTableTest, Empty)
+{
+    unf::ChangedFieldTable table;
+    ASSERT_TRUE(table.IsEmpty());
+    ASSERT_TRUE(table.IsConsolidated());
+    ASSERT_FALSE(table.Has(PXR_NS::SdfPath("/Foo")));
+    ASSERT_EQ(table.Get(PXR_NS::SdfPath("/Foo")), TfTokenSet{});
+    ASSERT_EQ(table.GetMap(), ChangedFieldMap{});
+}
+
+TEST(ChangedFieldTableTest, Add)
+{
+    unf::ChangedFieldTable table;
+    table.Add(
+        PXR_NS::SdfPath("/Foo"),
+        PXR_NS::TfTokenVector{
+            PXR_NS::TfToken("default"), PXR_NS::TfToken("typeName")});
+    table.Add(
+        PXR_NS::SdfPath("/Bar"), TfTokenSet{PXR_NS::TfToken("timeSamples")});
+
+    ASSERT_FALSE(table.IsEmpty());
+    ASSERT_FALSE(table.IsConsolidated());
+
+    ASSERT_TRUE(table.Has(PXR_NS::SdfPath("/Foo")));
+    ASSERT_TRUE(table.Has(PXR_NS::SdfPath("/Bar")));
+    ASSERT_FALSE(table.Has(PXR_NS::SdfPath("/Baz")));
+
+    ASSERT_EQ(
+        table.Get(PXR_NS::SdfPath("/Foo")),
+        TfTokenSet({PXR_NS::TfToken("default"), PXR_NS::TfToken("typeName")}));
+    ASSERT_EQ(
+        table.Get(PXR_NS::SdfPath("/Bar")),
+        TfTokenSet({PXR_NS::TfToken("timeSamples")}));
+}
+
+TEST(ChangedFieldTableTest, Merge)
+{
+    unf::ChangedFieldTable table1;
+    table1.Add(
+        PXR_NS::SdfPath("/Foo"), TfTokenSet{PXR_NS::TfToken("default")});
+
+    unf::ChangedFieldTable table2;
+    table2.Add(
+        PXR_NS::SdfPath("/Foo"), TfTokenSet{PXR_NS::TfToken("typeName")});
+    table2.Add(
+        PXR_NS::SdfPath("/Bar"), TfTokenSet{PXR_NS::TfToken("timeSamples")});
+
+    table1.Merge(std::move(table2));
+    ASSERT_FALSE(table1.IsConsolidated());
+
+    // Records of identical paths are combined before consolidation.
+    ASSERT_EQ(
+        table1.Get(PXR_NS::SdfPath("/Foo")),
+        TfTokenSet({PXR_NS::TfToken("default"), PXR_NS::TfToken("typeName")}));
+
+    table1.Consolidate();
+    ASSERT_TRUE(table1.IsConsolidated());
+
+    ASSERT_EQ(
+        table1.Get(PXR_NS::SdfPath("/Foo")),
+        TfTokenSet({PXR_NS::TfToken("default"), PXR_NS::TfToken("typeName")}));
+    ASSERT_EQ(
+        table1.Get(PXR_NS::SdfPath("/Bar")),
+        TfTokenSet({PXR_NS::TfToken("timeSamples")}));
+
+    ASSERT_EQ(
+        table1.GetMap(),
+        ChangedFieldMap(
+            {{PXR_NS::SdfPath("/Foo"),
+              TfTokenSet(
+                  {PXR_NS::TfToken("default"), PXR_NS::TfToken("typeName")})},
+             {PXR_NS::SdfPath("/Bar"),
+              TfTokenSet({PXR_NS::TfToken("timeSamples")})}}));
+}
+
+TEST(ChangedFieldTableTest, MergeOrdered)
+{
+    unf::ChangedFieldTable table1;
+    table1.Add(
+        PXR_NS::SdfPath("/Bar"), TfTokenSet{PXR_NS::TfToken("default")});
+
+    unf::ChangedFieldTable table2;
+    table2.Add(
+        PXR_NS::SdfPath("/Foo"), TfTokenSet{PXR_NS::TfToken("default")});
+
+    // Table remains consolidated when incoming paths are sorted after.
+    table1.Merge(std::move(table2));
+    ASSERT_TRUE(table1.IsConsolidated());
+    ASSERT_TRUE(table1.Has(PXR_NS::SdfPath("/Bar")));
+    ASSERT_TRUE(table1.Has(PXR_NS::SdfPath("/Foo")));
+}
+
+TEST(ChangedFieldTableTest, MergeRepeated)
+{
+    unf::ChangedFieldTable table;
+
+    // Records of identical paths are coalesced as the table grows.
+    for (size_t index = 0; index < 1000; ++index) {
+        unf::ChangedFieldTable incoming;
+        incoming.Add(
+            PXR_NS::SdfPath("/Foo"), TfTokenSet{PXR_NS::TfToken("default")});
+        incoming.Add(
+            PXR_NS::SdfPath("/Bar"),
+            TfTokenSet{PXR_NS::TfToken("timeSamples")});
+
+        table.Merge(std::move(incoming));
+        ASSERT_LE(table.GetSize(), 64);
+    }
+
+    ASSERT_EQ(
+        table.Get(PXR_NS::SdfPath("/Foo")),
+        TfTokenSet({PXR_NS::TfToken("default")}));
+    ASSERT_EQ(
+        table.Get(PXR_NS::SdfPath("/Bar")),
+        TfTokenSet({PXR_NS::TfToken("timeSamples")}));
+}
+
+TEST(ChangedFieldTableTest, SpilledFields)
+{
+    const PXR_NS::SdfPath path("/Foo");
+
+    // Register more fields than bitmasks can hold.
+    TfTokenSet expected;
+    for (size_t index = 0; index < 100; ++index) {
+        expected.insert(PXR_NS::TfToken("field" + std::to_string(index)));
+    }
+
+    unf::ChangedFieldTable table1;
+    table1.Add(path, expected);
+    table1.Add(PXR_NS::SdfPath("/Bar"), TfTokenSet{PXR_NS::TfToken("field99")});
+
+    unf::ChangedFieldTable table2;
+    table2.Add(path, expected);
+
+    table1.Merge(std::move(table2));
+    ASSERT_EQ(table1.Get(path), expected);
+
+    table1.Consolidate();
+    ASSERT_EQ(table1.Get(path), expected);
+    ASSERT_EQ(
+        table1.Get(PXR_NS::SdfPath("/Bar")),
+        TfTokenSet({PXR_NS::TfToken("field99")}));
+    ASSERT_EQ(table1.GetMap().at(path), expected);
+}
+
+TEST(ChangedFieldTableTest, Restrict)
+{
+    TfTokenSet fields;
+    for (size_t index = 0; index < 100; ++index) {
+        fields.insert(PXR_NS::TfToken("field" + std::to_string(index)));
+    }
+
+    unf::ChangedFieldTable table;
+    table.Add(PXR_NS::SdfPath("/Foo"), fields);
+    table.Add(PXR_NS::SdfPath("/Foo/Bar"), fields);
+    table.Add(PXR_NS::SdfPath("/Bar"), fields);
+    table.Add(PXR_NS::SdfPath("/Baz/Bim"), fields);
+
+    table.Restrict(
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath("/Foo"), PXR_NS::SdfPath("/Baz")});
+
+    // Spilled fields are restricted as well.
+    ASSERT_EQ(table.Get(PXR_NS::SdfPath("/Foo")), fields);
+    ASSERT_EQ(table.Get(PXR_NS::SdfPath("/Foo/Bar")), fields);
+    ASSERT_EQ(table.Get(PXR_NS::SdfPath("/Baz/Bim")), fields);
+    ASSERT_FALSE(table.Has(PXR_NS::SdfPath("/Bar")));
+    ASSERT_EQ(table.GetMap().size(), 3);
+
+    table.Restrict(PXR_NS::SdfPathVector{PXR_NS::SdfPath("/Incorrect")});
+    ASSERT_TRUE(table.IsEmpty());
+    ASSERT_EQ(table.GetMap(), ChangedFieldMap{});
+}
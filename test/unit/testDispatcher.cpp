@@ -82,3 +82,49 @@ TEST_F(DispatcherTest, AddNew)
     ASSERT_EQ(_listener.Received<::Test::OutputNotice1>(), 0);
     ASSERT_EQ(_listener.Received<::Test::OutputNotice2>(), 1);
 }
+
+TEST_F(DispatcherTest, DemandDriven)
+{
+    auto broker = unf::Broker::Create(_stage);
+    broker->AddDispatcher<::Test::NewDispatcher>();
+
+    ASSERT_FALSE(broker->IsDemandDriven());
+    broker->SetDemandDriven(true);
+    ASSERT_TRUE(broker->IsDemandDriven());
+
+    // Incoming notices are ignored while no output notices are in demand.
+    ::Test::InputNotice().Send(PXR_NS::TfWeakPtr<PXR_NS::UsdStage>(_stage));
+    ASSERT_EQ(_listener.Received<::Test::OutputNotice2>(), 0);
+
+    {
+        auto demand = broker->Demand<::Test::OutputNotice2>();
+        ASSERT_TRUE(broker->IsInDemand<::Test::OutputNotice2>());
+
+        ::Test::InputNotice().Send(
+            PXR_NS::TfWeakPtr<PXR_NS::UsdStage>(_stage));
+        ASSERT_EQ(_listener.Received<::Test::OutputNotice2>(), 1);
+    }
+
+    // Listeners are revoked when demand goes away.
+    ASSERT_FALSE(broker->IsInDemand<::Test::OutputNotice2>());
+
+    ::Test::InputNotice().Send(PXR_NS::TfWeakPtr<PXR_NS::UsdStage>(_stage));
+    ASSERT_EQ(_listener.Received<::Test::OutputNotice2>(), 1);
+
+    // Subscribed callbacks are in demand.
+    size_t received = 0;
+    auto subscription = broker->Subscribe<::Test::OutputNotice2>(
+        [&](const ::Test::OutputNotice2&) { received++; });
+
+    ::Test::InputNotice().Send(PXR_NS::TfWeakPtr<PXR_NS::UsdStage>(_stage));
+    ASSERT_EQ(received, 1);
+    ASSERT_EQ(_listener.Received<::Test::OutputNotice2>(), 2);
+
+    subscription.Reset();
+
+    // All listeners are registered when demand-driven mode is disabled.
+    broker->SetDemandDriven(false);
+
+    ::Test::InputNotice().Send(PXR_NS::TfWeakPtr<PXR_NS::UsdStage>(_stage));
+    ASSERT_EQ(_listener.Received<::Test::OutputNotice2>(), 3);
+}
@@ -0,0 +1,103 @@
+#include <unf/executor.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+TEST(ExecutorTest, Submit)
+{
+    auto executor = unf::ThreadExecutor::Create();
+
+    std::vector<size_t> results;
+    for (size_t index = 0; index < 100; ++index) {
+        executor->Submit([&, index]() { results.push_back(index); });
+    }
+
+    executor->Wait();
+
+    // Tasks are run in order of submission.
+    ASSERT_EQ(results.size(), 100);
+    for (size_t index = 0; index < 100; ++index) {
+        ASSERT_EQ(results[index], index);
+    }
+}
+
+TEST(ExecutorTest, RunOnDedicatedThread)
+{
+    auto executor = unf::ThreadExecutor::Create();
+
+    std::thread::id id;
+    executor->Submit([&]() { id = std::this_thread::get_id(); });
+    executor->Wait();
+
+    ASSERT_NE(id, std::thread::id());
+    ASSERT_NE(id, std::this_thread::get_id());
+}
+
+TEST(ExecutorTest, RunRemainingTasksOnDestruction)
+{
+    size_t count = 0;
+
+    {
+        auto executor = unf::ThreadExecutor::Create();
+        for (size_t index = 0; index < 10; ++index) {
+            executor->Submit([&]() { count += 1; });
+        }
+    }
+
+    ASSERT_EQ(count, 10);
+}
+
+TEST(ExecutorTest, WaitFromTask)
+{
+    auto executor = unf::ThreadExecutor::Create();
+
+    // Waiting from a task must not block the executor.
+    bool done = false;
+    executor->Submit([&]() {
+        executor->Wait();
+        done = true;
+    });
+    executor->Wait();
+
+    ASSERT_TRUE(done);
+}
+
+TEST(ExecutorTest, ReleaseFromTask)
+{
+    unf::ExecutorPtr executor = unf::ThreadExecutor::Create();
+
+    std::promise<void> started;
+    std::promise<void> finished;
+
+    // Last reference to the executor is released from a task, while
+    // another task remains to be run.
+    auto ready = started.get_future();
+    executor->Submit([&]() {
+        ready.wait();
+        executor = nullptr;
+    });
+    executor->Submit([&]() { finished.set_value(); });
+
+    started.set_value();
+
+    auto future = finished.get_future();
+    ASSERT_EQ(
+        future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+}
+
+TEST(ExecutorTest, TaskRaisingUnknownException)
+{
+    auto executor = unf::ThreadExecutor::Create();
+
+    // Exceptions not derived from std::exception must not stop the thread.
+    bool done = false;
+    executor->Submit([]() { throw 42; });
+    executor->Submit([&]() { done = true; });
+    executor->Wait();
+
+    ASSERT_TRUE(done);
+}
@@ -1,17 +1,24 @@
 #include <unf/broker.h>
 #include <unf/notice.h>
+#include <unf/transaction.h>
 
 #include <unfTest/observer.h>
 
 #include <gtest/gtest.h>
+#include <pxr/usd/sdf/changeBlock.h>
 #include <pxr/usd/sdf/layer.h>
 #include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/types.h>
 #include <pxr/usd/sdf/valueTypeName.h>
 #include <pxr/usd/usd/attribute.h>
 #include <pxr/usd/usd/prim.h>
 #include <pxr/usd/usd/primRange.h>
 #include <pxr/usd/usd/stage.h>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 class ObjectsChangedTest : public ::testing::Test {
   protected:
     void SetUp() override
@@ -301,3 +308,588 @@ TEST_F(ObjectsChangedTest, MergingResyncAndChangeInfo)
     ASSERT_NE(tokens.find(PXR_NS::TfToken{"specifier"}), tokens.end());
     ASSERT_NE(tokens.find(PXR_NS::TfToken{"typeName"}), tokens.end());
 }
+
+TEST_F(ObjectsChangedTest, MergingChangeInfoWithResyncedAncestor)
+{
+    auto prim1 = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _broker->BeginTransaction();
+    auto prim2 = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo/Bar"});
+    prim2.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    prim2.SetMetadata(PXR_NS::TfToken{"comment"}, "This is another test");
+    prim1.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    prim1.SetMetadata(PXR_NS::TfToken{"comment"}, "This is another test");
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(
+        n.GetResyncedPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo/Bar"}});
+
+    // Paths with resynced ancestor are skipped, and duplicated paths are
+    // only recorded once.
+    ASSERT_EQ(
+        n.GetChangedInfoOnlyPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo"}});
+
+    ASSERT_EQ(
+        n.GetChangedFields(PXR_NS::SdfPath{"/Foo/Bar"}),
+        unf::TfTokenSet(
+            {PXR_NS::TfToken{"specifier"}, PXR_NS::TfToken{"comment"}}));
+}
+
+TEST_F(ObjectsChangedTest, MergingChangeInfoWithResyncedAncestorInSameNotice)
+{
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"})
+        .CreateAttribute(
+            PXR_NS::TfToken{"test"}, PXR_NS::SdfValueTypeNames->Double);
+
+    auto _edit = [](const PXR_NS::UsdStageRefPtr& stage) {
+        stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+
+        // Resync prim and modify its attribute within a single notice.
+        PXR_NS::SdfChangeBlock block;
+        auto prim = stage->GetPrimAtPath(PXR_NS::SdfPath{"/Foo"});
+        prim.SetTypeName(PXR_NS::TfToken{"Xform"});
+        prim.GetAttribute(PXR_NS::TfToken{"test"}).Set(5.0);
+    };
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer1(_stage);
+
+    _broker->BeginTransaction();
+    _edit(_stage);
+    _broker->EndTransaction();
+
+    // Merge notices within a parallel reduction.
+    auto stage = PXR_NS::UsdStage::CreateInMemory();
+    stage->DefinePrim(PXR_NS::SdfPath{"/Foo"})
+        .CreateAttribute(
+            PXR_NS::TfToken{"test"}, PXR_NS::SdfValueTypeNames->Double);
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer2(stage);
+
+    auto broker = unf::Broker::Create(stage);
+    broker->SetParallelThreshold(2);
+
+    broker->BeginTransaction();
+    _edit(stage);
+    broker->EndTransaction();
+
+    ASSERT_EQ(observer1.Received(), 1);
+    ASSERT_EQ(observer2.Received(), 1);
+
+    // Modified path beneath a path resynced by the same notice is skipped.
+    for (const auto* n :
+         {&observer1.GetLatestNotice(), &observer2.GetLatestNotice()}) {
+        ASSERT_EQ(
+            n->GetResyncedPaths(),
+            PXR_NS::SdfPathVector(
+                {PXR_NS::SdfPath{"/Bar"}, PXR_NS::SdfPath{"/Foo"}}));
+        ASSERT_EQ(n->GetChangedInfoOnlyPaths(), PXR_NS::SdfPathVector{});
+    }
+}
+
+TEST_F(ObjectsChangedTest, MergingChangeInfoWithResyncedRoot)
+{
+    auto prim = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    auto layer = PXR_NS::SdfLayer::CreateAnonymous();
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _broker->BeginTransaction();
+    _stage->GetRootLayer()->InsertSubLayerPath(layer->GetIdentifier());
+    prim.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(
+        n.GetResyncedPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath::AbsoluteRootPath()});
+
+    // Resyncing the root does not skip paths modified beneath it.
+    const auto& paths = n.GetChangedInfoOnlyPaths();
+    ASSERT_NE(
+        std::find(paths.begin(), paths.end(), PXR_NS::SdfPath{"/Foo"}),
+        paths.end());
+}
+
+TEST_F(ObjectsChangedTest, MergingQueries)
+{
+    auto prim1 = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    auto prim2 = _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+    auto prim3 = _stage->DefinePrim(PXR_NS::SdfPath{"/Bim"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _broker->BeginTransaction();
+    prim1.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    prim2.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    auto prim4 = _stage->DefinePrim(PXR_NS::SdfPath{"/Bim/Baz"});
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    // Ensure that queries do not rely on the order of recorded paths.
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_TRUE(n.ChangedInfoOnly(prim1));
+    ASSERT_TRUE(n.ChangedInfoOnly(prim2));
+    ASSERT_FALSE(n.ChangedInfoOnly(prim3));
+    ASSERT_FALSE(n.ResyncedObject(prim1));
+    ASSERT_FALSE(n.ResyncedObject(prim3));
+    ASSERT_TRUE(n.ResyncedObject(prim4));
+    ASSERT_TRUE(n.AffectedObject(prim4));
+}
+
+TEST_F(ObjectsChangedTest, MergingParallelReduction)
+{
+    auto _edit = [](const PXR_NS::UsdStageRefPtr& stage) {
+        auto base = stage->GetPrimAtPath(PXR_NS::SdfPath{"/Base"});
+
+        for (size_t index = 0; index < 50; ++index) {
+            auto path = PXR_NS::SdfPath{"/Foo" + std::to_string(index)};
+            auto prim = stage->DefinePrim(path);
+            prim.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+            stage->DefinePrim(path.AppendChild(PXR_NS::TfToken{"Bar"}));
+            base.SetMetadata(
+                PXR_NS::TfToken{"comment"}, "Test " + std::to_string(index));
+        }
+    };
+
+    // Apply identical edits to a stage merging notices sequentially and to a
+    // stage merging notices within a parallel reduction.
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Base"});
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer1(_stage);
+
+    _broker->BeginTransaction();
+    _edit(_stage);
+    _broker->EndTransaction();
+
+    auto stage = PXR_NS::UsdStage::CreateInMemory();
+    stage->DefinePrim(PXR_NS::SdfPath{"/Base"});
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer2(stage);
+
+    auto broker = unf::Broker::Create(stage);
+    broker->SetParallelThreshold(2);
+
+    broker->BeginTransaction();
+    _edit(stage);
+    broker->EndTransaction();
+
+    ASSERT_EQ(observer1.Received(), 1);
+    ASSERT_EQ(observer2.Received(), 1);
+
+    const auto& n1 = observer1.GetLatestNotice();
+    const auto& n2 = observer2.GetLatestNotice();
+    ASSERT_EQ(n1.GetResyncedPaths().size(), 50);
+    ASSERT_EQ(n1.GetResyncedPaths(), n2.GetResyncedPaths());
+    ASSERT_EQ(n1.GetChangedInfoOnlyPaths(), n2.GetChangedInfoOnlyPaths());
+    ASSERT_EQ(n1.GetChangedFieldMap(), n2.GetChangedFieldMap());
+}
+
+TEST_F(ObjectsChangedTest, MergingParallelReductionInNestedTransaction)
+{
+    auto _edit = [](const PXR_NS::UsdStageRefPtr& stage,
+                    const unf::BrokerPtr& broker,
+                    bool nested) {
+        auto base = stage->GetPrimAtPath(PXR_NS::SdfPath{"/Base"});
+
+        broker->BeginTransaction();
+        base.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+
+        // Notices captured by the nested transaction are reduced before
+        // being joined into the enclosing transaction.
+        if (nested) {
+            broker->BeginTransaction(
+                [](const unf::UnfNotice::StageNotice&) { return true; });
+        }
+
+        for (size_t index = 0; index < 20; ++index) {
+            auto path = PXR_NS::SdfPath{"/Foo" + std::to_string(index)};
+            auto prim = stage->GetPrimAtPath(path);
+            auto child =
+                stage->GetPrimAtPath(path.AppendChild(PXR_NS::TfToken{"Bar"}));
+
+            // Modify child before resyncing its parent.
+            child.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+            prim.SetTypeName(PXR_NS::TfToken{"Xform"});
+        }
+
+        if (nested) {
+            broker->EndTransaction();
+        }
+
+        broker->EndTransaction();
+    };
+
+    auto _populate = [](const PXR_NS::UsdStageRefPtr& stage) {
+        stage->DefinePrim(PXR_NS::SdfPath{"/Base"});
+
+        for (size_t index = 0; index < 20; ++index) {
+            auto path = PXR_NS::SdfPath{"/Foo" + std::to_string(index)};
+            stage->DefinePrim(path.AppendChild(PXR_NS::TfToken{"Bar"}));
+        }
+    };
+
+    // Apply identical edits to a stage merging notices sequentially and to a
+    // stage reducing notices of a nested transaction concurrently.
+    _populate(_stage);
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer1(_stage);
+    _edit(_stage, _broker, false);
+
+    auto stage = PXR_NS::UsdStage::CreateInMemory();
+    _populate(stage);
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer2(stage);
+
+    auto broker = unf::Broker::Create(stage);
+    broker->SetParallelThreshold(2);
+    _edit(stage, broker, true);
+
+    ASSERT_EQ(observer1.Received(), 1);
+    ASSERT_EQ(observer2.Received(), 1);
+
+    const auto& n1 = observer1.GetLatestNotice();
+    const auto& n2 = observer2.GetLatestNotice();
+    ASSERT_EQ(n1.GetChangedInfoOnlyPaths().size(), 21);
+    ASSERT_EQ(n1.GetResyncedPaths(), n2.GetResyncedPaths());
+    ASSERT_EQ(n1.GetChangedInfoOnlyPaths(), n2.GetChangedInfoOnlyPaths());
+    ASSERT_EQ(n1.GetChangedFieldMap(), n2.GetChangedFieldMap());
+}
+
+TEST_F(ObjectsChangedTest, MergingNestedTransaction)
+{
+    auto _edit = [](const PXR_NS::UsdStageRefPtr& stage,
+                    const unf::BrokerPtr& broker,
+                    bool nested) {
+        auto prim1 = stage->GetPrimAtPath(PXR_NS::SdfPath{"/Foo"});
+        auto prim2 = stage->GetPrimAtPath(PXR_NS::SdfPath{"/Bar"});
+
+        broker->BeginTransaction();
+        prim2.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+
+        // Nested transaction with a distinct predicate is joined into the
+        // enclosing transaction when it ends.
+        if (nested) {
+            broker->BeginTransaction(
+                [](const unf::UnfNotice::StageNotice&) { return true; });
+        }
+
+        // Modify attribute before resyncing its prim.
+        prim1.GetAttribute(PXR_NS::TfToken{"test"}).Set(5.0);
+        prim1.SetTypeName(PXR_NS::TfToken{"Xform"});
+
+        if (nested) {
+            broker->EndTransaction();
+        }
+
+        broker->EndTransaction();
+    };
+
+    auto _createStage = []() {
+        auto stage = PXR_NS::UsdStage::CreateInMemory();
+        stage->DefinePrim(PXR_NS::SdfPath{"/Foo"})
+            .CreateAttribute(
+                PXR_NS::TfToken{"test"}, PXR_NS::SdfValueTypeNames->Double);
+        stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+        return stage;
+    };
+
+    // Apply identical edits within a single transaction and within a nested
+    // transaction.
+    auto stage1 = _createStage();
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer1(stage1);
+    _edit(stage1, unf::Broker::Create(stage1), false);
+
+    auto stage2 = _createStage();
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer2(stage2);
+    _edit(stage2, unf::Broker::Create(stage2), true);
+
+    ASSERT_EQ(observer1.Received(), 1);
+    ASSERT_EQ(observer2.Received(), 1);
+
+    const auto& n1 = observer1.GetLatestNotice();
+    const auto& n2 = observer2.GetLatestNotice();
+    ASSERT_EQ(
+        n1.GetResyncedPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo"}});
+    ASSERT_EQ(
+        n1.GetChangedInfoOnlyPaths(),
+        PXR_NS::SdfPathVector(
+            {PXR_NS::SdfPath{"/Bar"}, PXR_NS::SdfPath{"/Foo.test"}}));
+    ASSERT_EQ(n1.GetResyncedPaths(), n2.GetResyncedPaths());
+    ASSERT_EQ(n1.GetChangedInfoOnlyPaths(), n2.GetChangedInfoOnlyPaths());
+    ASSERT_EQ(n1.GetChangedFieldMap(), n2.GetChangedFieldMap());
+}
+
+TEST_F(ObjectsChangedTest, FindResyncedPaths)
+{
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _broker->BeginTransaction();
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo/Baz"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo/Bar"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Bim"});
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+
+    auto range1 = n.FindResyncedPaths(PXR_NS::SdfPath{"/Foo"});
+    ASSERT_EQ(
+        PXR_NS::SdfPathVector(range1.begin(), range1.end()),
+        PXR_NS::SdfPathVector(
+            {PXR_NS::SdfPath{"/Foo/Bar"}, PXR_NS::SdfPath{"/Foo/Baz"}}));
+
+    auto range2 = n.FindResyncedPaths(PXR_NS::SdfPath{"/Bim"});
+    ASSERT_EQ(range2.size(), 1);
+    ASSERT_EQ(*range2.begin(), PXR_NS::SdfPath{"/Bim"});
+
+    auto range3 = n.FindResyncedPaths(PXR_NS::SdfPath{"/Incorrect"});
+    ASSERT_TRUE(range3.empty());
+}
+
+TEST_F(ObjectsChangedTest, FindChangedInfoOnlyPaths)
+{
+    auto prim1 = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    auto prim2 = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo/Bar"});
+    auto prim3 = _stage->DefinePrim(PXR_NS::SdfPath{"/Bim"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _broker->BeginTransaction();
+    prim3.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    prim2.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    prim1.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+
+    // Paths are returned in lexicographical order.
+    auto range1 = n.FindChangedInfoOnlyPaths(PXR_NS::SdfPath{"/Foo"});
+    ASSERT_EQ(
+        PXR_NS::SdfPathVector(range1.begin(), range1.end()),
+        PXR_NS::SdfPathVector(
+            {PXR_NS::SdfPath{"/Foo"}, PXR_NS::SdfPath{"/Foo/Bar"}}));
+
+    auto range2 = n.FindChangedInfoOnlyPaths(PXR_NS::SdfPath{"/Incorrect"});
+    ASSERT_TRUE(range2.empty());
+}
+
+TEST_F(ObjectsChangedTest, GetChangedFieldsRef)
+{
+    auto prim = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    prim.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+    const auto& tokens = n.GetChangedFieldsRef(PXR_NS::SdfPath{"/Foo"});
+    ASSERT_EQ(tokens, unf::TfTokenSet{PXR_NS::TfToken{"comment"}});
+
+    // Same set is returned for successive calls.
+    ASSERT_EQ(&tokens, &n.GetChangedFieldsRef(prim));
+
+    ASSERT_TRUE(n.GetChangedFieldsRef(PXR_NS::SdfPath{"/Incorrect"}).empty());
+}
+
+TEST_F(ObjectsChangedTest, GetChangedFieldsRefWithinTransaction)
+{
+    auto prim1 = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    auto prim2 = _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _broker->BeginTransaction();
+    prim1.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    prim2.SetMetadata(PXR_NS::TfToken{"documentation"}, "This is a test");
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    // Fields are resolved for each path requested from the merged notice.
+    const auto& n = observer.GetLatestNotice();
+    const auto& tokens1 = n.GetChangedFieldsRef(PXR_NS::SdfPath{"/Foo"});
+    const auto& tokens2 = n.GetChangedFieldsRef(PXR_NS::SdfPath{"/Bar"});
+    ASSERT_EQ(tokens1, unf::TfTokenSet{PXR_NS::TfToken{"comment"}});
+    ASSERT_EQ(tokens2, unf::TfTokenSet{PXR_NS::TfToken{"documentation"}});
+
+    // Same sets are returned for successive calls.
+    ASSERT_EQ(&tokens1, &n.GetChangedFieldsRef(prim1));
+    ASSERT_EQ(&tokens2, &n.GetChangedFieldsRef(prim2));
+
+    // Sets are identical to those of the map of all changed fields.
+    const auto& map = n.GetChangedFieldMap();
+    ASSERT_EQ(tokens1, map.at(PXR_NS::SdfPath{"/Foo"}));
+    ASSERT_EQ(tokens2, map.at(PXR_NS::SdfPath{"/Bar"}));
+}
+
+TEST_F(ObjectsChangedTest, TransactionWithScope)
+{
+    auto prim1 = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    auto prim2 = _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _broker->BeginTransaction(
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo"}});
+    prim1.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    prim2.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo/Baz"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Bar/Baz"});
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    // Changes outside of the scope are trimmed.
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(
+        n.GetResyncedPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo/Baz"}});
+    ASSERT_EQ(
+        n.GetChangedInfoOnlyPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo"}});
+    ASSERT_TRUE(n.HasChangedFields(PXR_NS::SdfPath{"/Foo"}));
+    ASSERT_FALSE(n.HasChangedFields(PXR_NS::SdfPath{"/Bar"}));
+    ASSERT_FALSE(n.AffectedObject(prim2));
+}
+
+TEST_F(ObjectsChangedTest, NoticeTransactionWithScope)
+{
+    auto prim1 = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    auto prim2 = _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    {
+        unf::NoticeTransaction transaction(
+            _broker, PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo"}});
+        prim1.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+        prim2.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    }
+
+    {
+        unf::NoticeTransaction transaction(
+            _stage, PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Bar"}});
+        prim1.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+        prim2.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    }
+
+    ASSERT_EQ(observer.Received(), 2);
+
+    // Changes outside of the scope are trimmed.
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(n.GetResyncedPaths(), PXR_NS::SdfPathVector{});
+    ASSERT_EQ(
+        n.GetChangedInfoOnlyPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Bar"}});
+}
+
+TEST_F(ObjectsChangedTest, TransactionWithScopeAndSharedNotice)
+{
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _broker->BeginTransaction();
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    // Notice is held by another owner while it is sent.
+    unf::UnfNotice::StageNoticeRefPtr notice =
+        observer.GetLatestNotice().Clone();
+    std::vector<unf::UnfNotice::StageNoticeRefPtr> owner{notice};
+
+    _broker->BeginTransaction(
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo"}});
+    _broker->Send(notice);
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 2);
+
+    // Notice emitted is trimmed, but notice sent is not modified.
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(
+        n.GetResyncedPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo"}});
+
+    const auto& sent =
+        static_cast<const unf::UnfNotice::ObjectsChanged&>(*owner[0]);
+    ASSERT_EQ(
+        sent.GetResyncedPaths(),
+        PXR_NS::SdfPathVector(
+            {PXR_NS::SdfPath{"/Bar"}, PXR_NS::SdfPath{"/Foo"}}));
+}
+
+TEST_F(ObjectsChangedTest, TransactionWithScopeAndResyncedAncestor)
+{
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo/Bar"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    // Resyncing an ancestor is reported as resyncing the scope.
+    _broker->BeginTransaction(
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo/Bar"}});
+    _stage->RemovePrim(PXR_NS::SdfPath{"/Foo"});
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(
+        n.GetResyncedPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo/Bar"}});
+}
+
+TEST_F(ObjectsChangedTest, TransactionWithScopeDiscarded)
+{
+    auto prim = _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    // Notices with no changes in scope are not emitted.
+    _broker->BeginTransaction(
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo"}});
+    prim.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 0);
+}
+
+TEST_F(ObjectsChangedTest, NestedTransactionWithScope)
+{
+    auto prim1 = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    auto prim2 = _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    // Nested transactions are restricted to the scope of enclosing
+    // transactions.
+    _broker->BeginTransaction(
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo"}});
+    _broker->BeginTransaction();
+    prim1.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    prim2.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    _broker->EndTransaction();
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(
+        n.GetChangedInfoOnlyPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo"}});
+}
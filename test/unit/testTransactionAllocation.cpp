@@ -0,0 +1,197 @@
+#include <unf/broker.h>
+#include <unf/notice.h>
+
+#include <unfTest/notice.h>
+#include <unfTest/observer.h>
+
+#include <gtest/gtest.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+// Count allocations made through the global allocator.
+static std::atomic<size_t> allocations{0};
+
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* pointer = std::malloc(size ? size : 1)) return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+class TransactionAllocationTest : public ::testing::Test {
+  protected:
+    // Number of transactions started for each measurement.
+    static constexpr size_t Iterations = 100000;
+
+    void SetUp() override
+    {
+        _stage = PXR_NS::UsdStage::CreateInMemory();
+        _broker = unf::Broker::Create(_stage);
+    }
+
+    // Run \p body \p iterations times, record the average duration of each
+    // run and return the number of allocations made.
+    size_t _Measure(size_t iterations, const std::function<void()>& body)
+    {
+        // Warm up so that the transaction stack, the merger pool and lists
+        // of notices held by recycled mergers are allocated.
+        body();
+
+        auto start = std::chrono::steady_clock::now();
+        size_t count = allocations.load();
+
+        for (size_t i = 0; i < iterations; ++i) {
+            body();
+        }
+
+        size_t allocated = allocations.load() - count;
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        RecordProperty(
+            "nanoseconds_per_transaction",
+            std::to_string(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                    .count() /
+                iterations));
+
+        return allocated;
+    }
+
+    PXR_NS::UsdStageRefPtr _stage;
+    unf::BrokerPtr _broker;
+};
+
+TEST_F(TransactionAllocationTest, EmptyTransaction)
+{
+    size_t allocated = _Measure(Iterations, [&]() {
+        _broker->BeginTransaction();
+        _broker->EndTransaction();
+    });
+
+    ASSERT_EQ(allocated, 0);
+}
+
+TEST_F(TransactionAllocationTest, NestedEmptyTransaction)
+{
+    auto predicate = unf::CapturePredicate::BlockAll();
+
+    size_t allocated = _Measure(Iterations, [&]() {
+        _broker->BeginTransaction();
+        _broker->BeginTransaction(predicate);
+        _broker->EndTransaction();
+        _broker->EndTransaction();
+    });
+
+    ASSERT_EQ(allocated, 0);
+}
+
+TEST_F(TransactionAllocationTest, NestedTransactionWithEnclosingPredicate)
+{
+    auto outer = unf::CapturePredicate::BlockAll();
+    auto inner = unf::CapturePredicate::Not(outer);
+
+    PXR_NS::SdfPathVector scope = {PXR_NS::SdfPath("/Foo")};
+
+    // Enclosing transaction is started once, with a predicate and a scope.
+    _broker->BeginTransaction(scope, outer);
+
+    size_t allocated = _Measure(Iterations, [&]() {
+        _broker->BeginTransaction(inner);
+        _broker->EndTransaction();
+    });
+
+    _broker->EndTransaction();
+
+    ASSERT_EQ(allocated, 0);
+}
+
+TEST_F(TransactionAllocationTest, TransactionWithNotices)
+{
+    // Notices are not sent as TfNotice to only measure capture.
+    _broker->SetTfNoticeDelivery(false);
+
+    // Notices are created beforehand so that only capture is measured.
+    std::vector<PXR_NS::TfRefPtr<::Test::MergeableNotice> > notices;
+    for (size_t i = 0; i < 10; ++i) {
+        notices.push_back(::Test::MergeableNotice::Create());
+    }
+
+    size_t allocated = _Measure(Iterations / 10, [&]() {
+        _broker->BeginTransaction();
+        for (const auto& notice : notices) {
+            _broker->Send(notice);
+        }
+        _broker->EndTransaction();
+    });
+
+    // Notices captured are held within lists recycled with their mergers.
+    ASSERT_EQ(allocated, 0);
+}
+
+TEST_F(TransactionAllocationTest, RecycledObjectsChangedPaths)
+{
+    // Number of notice copies for each measurement.
+    constexpr size_t copies = 1000;
+
+    auto prim = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    // Notice holding resynced paths and paths modified but not resynced.
+    _broker->BeginTransaction();
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+    prim.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+    const auto& notice = observer.GetLatestNotice();
+
+    // Copies kept alive cannot reuse memory of each other.
+    std::vector<unf::UnfNotice::ObjectsChanged> notices;
+    notices.reserve(copies);
+
+    size_t count = allocations.load();
+
+    for (size_t i = 0; i < copies; ++i) {
+        notices.emplace_back(notice);
+    }
+
+    size_t allocatedAlive = allocations.load() - count;
+    notices.clear();
+
+    // Copies released before the next one is made recycle path vectors.
+    count = allocations.load();
+
+    for (size_t i = 0; i < copies; ++i) {
+        unf::UnfNotice::ObjectsChanged copy(notice);
+    }
+
+    size_t allocatedRecycled = allocations.load() - count;
+
+    // Paths copied into recycled vectors are unchanged.
+    unf::UnfNotice::ObjectsChanged copy(notice);
+    ASSERT_EQ(copy.GetResyncedPaths(), notice.GetResyncedPaths());
+    ASSERT_EQ(
+        copy.GetChangedInfoOnlyPaths(), notice.GetChangedInfoOnlyPaths());
+
+    // At least one allocation is saved per copy, as only a bounded number
+    // of vectors is kept per thread.
+    ASSERT_LE(allocatedRecycled + copies, allocatedAlive);
+}
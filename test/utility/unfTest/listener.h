@@ -9,6 +9,7 @@
 #include <string>
 #include <typeinfo>
 #include <unordered_map>
+#include <vector>
 
 namespace Test {
 
@@ -42,11 +43,15 @@ class Listener : public PXR_NS::TfWeakBase {
         return _received.at(name);
     }
 
+    // Return type names of notices in the order they were received.
+    const std::vector<std::string>& History() const { return _history; }
+
     void Reset()
     {
         for (auto& element : _received) {
             element.second = 0;
         }
+        _history.clear();
     }
 
   private:
@@ -70,10 +75,12 @@ class Listener : public PXR_NS::TfWeakBase {
         if (_received.find(name) == _received.end()) _received[name] = 0;
 
         _received[name] += 1;
+        _history.push_back(name);
     }
 
     std::unordered_map<std::string, PXR_NS::TfNotice::Key> _keys;
     std::unordered_map<std::string, size_t> _received;
+    std::vector<std::string> _history;
 };
 
 }  // namespace Test